@@ -0,0 +1,284 @@
+#ifndef ALGORITHM_H
+#define ALGORITHM_H
+
+#include "compare.h"
+#include "constraints.h"
+#include "segmented_iterator.h"
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+// Constrained algorithms.
+// These have the same meaning as their namesakes in <algorithm>, but pick a faster
+// implementation when the constraints checks show that one applies.
+
+namespace Estd {
+
+// Three-way quicksort, for keys that compare_3way compares in one call.
+#include "impl/three_way_sort.h"
+
+// Radix sort support.
+#include "impl/radix_sort.h"
+
+// Loops over the segments of segmented iterators.
+#include "impl/segmented.h"
+
+// equal and mismatch over arrays of Bitwise_comparable values.
+#include "impl/bitwise.h"
+
+// Sentinel-delimited algorithms.
+#include "impl/single_pass.h"
+
+// sort - pg. 940
+//
+// When the value type is an integral or floating point type, the elements are radix sorted.
+// Values that compare_3way compares in one call, such as strings and tuples, are sorted by
+// three-way quicksort. Otherwise this is std::sort. Radix sort is stable, but callers should
+// not rely on it, since short sequences always go to std::sort.
+
+template<typename I>
+  void sort(I first, I last)
+  {
+    static_assert(Random_access_iterator<I>(), "sort: requires random access iterators");
+    static_assert(Weakly_ordered<Value_type<I>>(), "sort: requires an ordered value type");
+
+    impl::sort_by_key(first, last, impl::identity_key{},
+                      boolean_constant<impl::Radix_sortable<I, impl::identity_key>()>{});
+  }
+
+// Sort with a comparison. A comparison is opaque, so this is always std::sort.
+template<typename I, typename C>
+  auto sort(I first, I last, C comp)
+    -> Enable_if<Predicate<C, Value_type<I>, Value_type<I>>()>
+  {
+    static_assert(Random_access_iterator<I>(), "sort: requires random access iterators");
+
+    std::sort(first, last, comp);
+  }
+
+// Sort by a key extracted from each element, e.g. [](const Record& r) { return r.id; }.
+// Elements with integral or floating point keys are radix sorted when the value type can
+// be default constructed for the buffer; anything else compares the keys, with compare_3way
+// or <, as sort(first, last) does.
+template<typename I, typename K>
+  auto sort(I first, I last, K key)
+    -> Enable_if<!Predicate<K, Value_type<I>, Value_type<I>>()
+              && Has_call<K, const Value_type<I>&>()>
+  {
+    static_assert(Random_access_iterator<I>(), "sort: requires random access iterators");
+    static_assert(Weakly_ordered<Decay<Result_of<K(const Value_type<I>&)>>>(), "sort: requires an ordered key type");
+
+    impl::sort_by_key(first, last, key, boolean_constant<impl::Radix_sortable<I, K>()>{});
+  }
+
+// Single-pass algorithms - pg. 930
+//
+// These take an iterator and a sentinel, or a Range, and walk the sequence once. A delimited
+// sequence such as cstring(p) is processed without first being scanned for its end. Given
+// an iterator pair, they call the standard algorithm.
+
+template<typename I, typename S, typename F>
+  auto for_each(I first, S last, F f)
+    -> Enable_if<Sentinel_for<S, I>(), F>
+  {
+    static_assert(Input_iterator<I>(), "for_each: requires input iterators");
+
+    return impl::for_each(first, last, std::move(f));
+  }
+
+template<typename R, typename F>
+  auto for_each(R&& r, F f)
+    -> Enable_if<Range<R>(), F>
+  {
+    using std::begin;
+    using std::end;
+    return Estd::for_each(begin(r), end(r), std::move(f));
+  }
+
+template<typename I, typename S, typename T>
+  auto find(I first, S last, const T& value)
+    -> Enable_if<Sentinel_for<S, I>(), I>
+  {
+    static_assert(Input_iterator<I>(), "find: requires input iterators");
+    static_assert(Equality_comparable<Value_type<I>, T>(), "find: requires values comparable with the elements");
+
+    return impl::find(first, last, value);
+  }
+
+template<typename R, typename T>
+  auto find(R&& r, const T& value)
+    -> Enable_if<Range<R>(), Iterator_of<R>>
+  {
+    using std::begin;
+    using std::end;
+    return Estd::find(begin(r), end(r), value);
+  }
+
+template<typename I, typename S, typename P>
+  auto find_if(I first, S last, P pred)
+    -> Enable_if<Sentinel_for<S, I>(), I>
+  {
+    static_assert(Input_iterator<I>(), "find_if: requires input iterators");
+    static_assert(Predicate<P, Value_type<I>>(), "find_if: requires a Predicate on the elements");
+
+    return impl::find_if(first, last, pred);
+  }
+
+template<typename R, typename P>
+  auto find_if(R&& r, P pred)
+    -> Enable_if<Range<R>(), Iterator_of<R>>
+  {
+    using std::begin;
+    using std::end;
+    return Estd::find_if(begin(r), end(r), pred);
+  }
+
+template<typename I, typename S, typename T>
+  auto count(I first, S last, const T& value)
+    -> Enable_if<Sentinel_for<S, I>(), Difference_type<I>>
+  {
+    static_assert(Input_iterator<I>(), "count: requires input iterators");
+    static_assert(Equality_comparable<Value_type<I>, T>(), "count: requires values comparable with the elements");
+
+    return impl::count(first, last, value);
+  }
+
+template<typename R, typename T>
+  auto count(R&& r, const T& value)
+    -> Enable_if<Range<R>(), Difference_type<Iterator_of<R>>>
+  {
+    using std::begin;
+    using std::end;
+    return Estd::count(begin(r), end(r), value);
+  }
+
+template<typename I, typename S, typename P>
+  auto count_if(I first, S last, P pred)
+    -> Enable_if<Sentinel_for<S, I>(), Difference_type<I>>
+  {
+    static_assert(Input_iterator<I>(), "count_if: requires input iterators");
+    static_assert(Predicate<P, Value_type<I>>(), "count_if: requires a Predicate on the elements");
+
+    return impl::count_if(first, last, pred);
+  }
+
+template<typename R, typename P>
+  auto count_if(R&& r, P pred)
+    -> Enable_if<Range<R>(), Difference_type<Iterator_of<R>>>
+  {
+    using std::begin;
+    using std::end;
+    return Estd::count_if(begin(r), end(r), pred);
+  }
+
+template<typename I, typename S, typename O>
+  auto copy(I first, S last, O out)
+    -> Enable_if<Sentinel_for<S, I>(), O>
+  {
+    static_assert(Input_iterator<I>(), "copy: requires input iterators");
+    static_assert(Writable<O, Dereference_result<I>>(), "copy: requires an output iterator for the elements");
+
+    return impl::copy(first, last, out);
+  }
+
+template<typename R, typename O>
+  auto copy(R&& r, O out)
+    -> Enable_if<Range<R>(), O>
+  {
+    using std::begin;
+    using std::end;
+    return Estd::copy(begin(r), end(r), out);
+  }
+
+// Unlike std::fill, this returns the end of the filled sequence, which a sentinel
+// doesn't give the caller.
+template<typename I, typename S, typename T>
+  auto fill(I first, S last, const T& value)
+    -> Enable_if<Sentinel_for<S, I>(), I>
+  {
+    static_assert(Forward_iterator<I>(), "fill: requires forward iterators");
+    static_assert(Writable<I, const T&>(), "fill: requires a value assignable to the elements");
+
+    return impl::fill(first, last, value);
+  }
+
+template<typename R, typename T>
+  auto fill(R&& r, const T& value)
+    -> Enable_if<Range<R>(), Iterator_of<R>>
+  {
+    using std::begin;
+    using std::end;
+    return Estd::fill(begin(r), end(r), value);
+  }
+
+// The second sequence must be at least as long as the first.
+template<typename I1, typename S1, typename I2>
+  auto mismatch(I1 first1, S1 last1, I2 first2)
+    -> Enable_if<Sentinel_for<S1, I1>(), std::pair<I1, I2>>
+  {
+    static_assert(Input_iterator<I1>() && Input_iterator<I2>(), "mismatch: requires input iterators");
+    static_assert(Equality_comparable<Value_type<I1>, Value_type<I2>>(), "mismatch: requires comparable elements");
+
+    return impl::mismatch(first1, last1, first2);
+  }
+
+template<typename I1, typename S1, typename I2, typename S2>
+  auto mismatch(I1 first1, S1 last1, I2 first2, S2 last2)
+    -> Enable_if<Sentinel_for<S1, I1>() && Sentinel_for<S2, I2>(), std::pair<I1, I2>>
+  {
+    static_assert(Input_iterator<I1>() && Input_iterator<I2>(), "mismatch: requires input iterators");
+    static_assert(Equality_comparable<Value_type<I1>, Value_type<I2>>(), "mismatch: requires comparable elements");
+
+    return impl::mismatch(first1, last1, first2, last2);
+  }
+
+template<typename R1, typename R2>
+  auto mismatch(R1&& r1, R2&& r2)
+    -> Enable_if<Range<R1>() && Range<R2>(), std::pair<Iterator_of<R1>, Iterator_of<R2>>>
+  {
+    static_assert(Equality_comparable<Value_type<R1>, Value_type<R2>>(), "mismatch: requires comparable elements");
+
+    return impl::mismatch_ranges(std::forward<R1>(r1), std::forward<R2>(r2),
+                                 boolean_constant<impl::Bitwise_ranges<R1, R2>()>{});
+  }
+
+// The second sequence must be at least as long as the first.
+template<typename I1, typename S1, typename I2>
+  auto equal(I1 first1, S1 last1, I2 first2)
+    -> Enable_if<Sentinel_for<S1, I1>(), bool>
+  {
+    static_assert(Input_iterator<I1>() && Input_iterator<I2>(), "equal: requires input iterators");
+    static_assert(Equality_comparable<Value_type<I1>, Value_type<I2>>(), "equal: requires comparable elements");
+
+    return impl::equal(first1, last1, first2);
+  }
+
+template<typename I1, typename S1, typename I2, typename S2>
+  auto equal(I1 first1, S1 last1, I2 first2, S2 last2)
+    -> Enable_if<Sentinel_for<S1, I1>() && Sentinel_for<S2, I2>(), bool>
+  {
+    static_assert(Input_iterator<I1>() && Input_iterator<I2>(), "equal: requires input iterators");
+    static_assert(Equality_comparable<Value_type<I1>, Value_type<I2>>(), "equal: requires comparable elements");
+
+    return impl::equal(first1, last1, first2, last2);
+  }
+
+template<typename R1, typename R2>
+  auto equal(const R1& r1, const R2& r2)
+    -> Enable_if<Range<R1>() && Range<R2>(), bool>
+  {
+    static_assert(Equality_comparable<Value_type<R1>, Value_type<R2>>(), "equal: requires comparable elements");
+
+    return impl::equal_ranges(r1, r2, boolean_constant<impl::Bitwise_ranges<const R1&, const R2&>()>{});
+  }
+
+}	// namespace Estd
+
+#endif	// ALGORITHM_H
@@ -0,0 +1,102 @@
+// Compile-time benchmark for Has_call, Result_of and Predicate.
+//
+// 500 distinct callables, each queried with a handful of argument shapes: function objects
+// with overloaded call operators, lambdas, function pointers, and pointers to member
+// functions and data. Half the queries fail, as they do when a constrained overload is
+// rejected. Nothing is run; time the front end:
+//
+//   time g++ -std=c++17 -fsyntax-only -I.. compile_time_invoke.cpp
+//   time g++ -std=c++17 -fsyntax-only -I.. -DBENCH_STD compile_time_invoke.cpp
+//   time g++ -std=c++17 -fsyntax-only -I.. -DBENCH_NONE compile_time_invoke.cpp
+//
+// BENCH_STD answers the same queries with std::is_invocable and std::invoke_result (C++17),
+// and BENCH_NONE with constants, for the cost of the declarations alone. -ftime-report breaks
+// the time down; its "overload resolution" line is the one the invoke engine shows up in.
+
+#include "traits.h"
+#include "constraints.h"
+#include <array>
+#include <string>
+#include <type_traits>
+
+namespace bench {
+
+struct S {
+  int m;
+  int f(int) const;
+  double g(double, int);
+};
+
+using MF = int (S::*)(int) const;
+using MG = double (S::*)(double, int);
+using MD = int S::*;
+
+#if defined(BENCH_NONE)
+template<typename F, typename... Args>
+  constexpr bool callable() { return true; }
+
+template<typename F, typename... Args>
+  constexpr bool not_callable() { return true; }
+
+template<typename F, typename... Args>
+  using result = int;
+#elif defined(BENCH_STD)
+template<typename F, typename... Args>
+  constexpr bool callable() { return std::is_invocable<F, Args...>::value; }
+
+template<typename F, typename... Args>
+  constexpr bool not_callable() { return !std::is_invocable<F, Args...>::value; }
+
+template<typename F, typename... Args>
+  using result = std::invoke_result_t<F, Args...>;
+#else
+template<typename F, typename... Args>
+  constexpr bool callable() { return Estd::Has_call<F, Args...>(); }
+
+template<typename F, typename... Args>
+  constexpr bool not_callable() { return !Estd::Has_call<F, Args...>(); }
+
+template<typename F, typename... Args>
+  using result = Estd::Result_of<F(Args...)>;
+#endif
+
+// Each shape is distinct per N, so that nothing is memoized across them.
+#define BENCH_SHAPE(N)                                                                        \
+  struct F##N {                                                                               \
+    int operator()(int, const std::string&) const;                                            \
+    void operator()(S&) const;                                                                \
+  };                                                                                          \
+  int fn##N(long, S*);                                                                        \
+  using P##N = decltype(&fn##N);                                                              \
+  using A##N = std::array<int, N + 1>;                                                        \
+  auto l##N = [](A##N& a) { return a.size() > 0; };                                           \
+  using L##N = decltype(l##N);                                                                \
+  static_assert(callable<F##N, int, std::string&>(), "");                                     \
+  static_assert(callable<const F##N&, S&>(), "");                                             \
+  static_assert(not_callable<F##N, S*>(), "");                                                \
+  static_assert(callable<P##N, int, S*>(), "");                                               \
+  static_assert(callable<L##N&, A##N&>(), "");                                                \
+  static_assert(not_callable<L##N, const A##N&>(), "");                                       \
+  static_assert(not_callable<MF, std::array<S, N + 1>, int>(), "");                           \
+  using RA##N = result<MF, const S&, A##N::size_type>;                                        \
+  using RB##N = result<MG, S*, float, long>;                                                  \
+  using RC##N = result<MD, S&>;                                                               \
+  using RL##N = result<L##N, A##N&>;
+
+#define BENCH_10(N)                                                                           \
+  BENCH_SHAPE(N##0) BENCH_SHAPE(N##1) BENCH_SHAPE(N##2) BENCH_SHAPE(N##3) BENCH_SHAPE(N##4)  \
+  BENCH_SHAPE(N##5) BENCH_SHAPE(N##6) BENCH_SHAPE(N##7) BENCH_SHAPE(N##8) BENCH_SHAPE(N##9)
+
+#define BENCH_100(N)                                                                          \
+  BENCH_10(N##0) BENCH_10(N##1) BENCH_10(N##2) BENCH_10(N##3) BENCH_10(N##4)                 \
+  BENCH_10(N##5) BENCH_10(N##6) BENCH_10(N##7) BENCH_10(N##8) BENCH_10(N##9)
+
+BENCH_100(1)
+BENCH_100(2)
+BENCH_100(3)
+BENCH_100(4)
+BENCH_100(5)
+
+}	// namespace bench
+
+int main() { }
@@ -0,0 +1,73 @@
+// Run-time benchmark for enum_map and enum_set against std::map and std::set.
+//
+// Each test handles 1M messages, each of one of 12 kinds. A handler counts the messages of
+// each kind in a map, and skips the kinds in a set of muted kinds:
+//
+//   g++ -std=c++11 -O2 -I.. enum.cpp && ./a.out
+
+#include "enum.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace bench {
+
+ESTD_ENUM(kind, std::uint8_t,
+          hello, ping, pong, subscribe, unsubscribe, publish,
+          ack, nack, query, reply, error, bye);
+
+// Runs f until 0.2 s have gone by, and returns the time per call in microseconds.
+template<typename F>
+  double time(F f)
+  {
+    using clock = std::chrono::steady_clock;
+    std::size_t sink = 0;
+    std::size_t calls = 0;
+    auto start = clock::now();
+    double elapsed;
+    do {
+      sink += f();
+      ++calls;
+      elapsed = std::chrono::duration<double>(clock::now() - start).count();
+    } while (elapsed < 0.2);
+    volatile std::size_t keep = sink;
+    (void)keep;
+    return elapsed / calls * 1e6;
+  }
+
+}	// namespace bench
+
+int main()
+{
+  using namespace bench;
+
+  const std::size_t n = 1 << 20;
+  std::vector<kind> messages(n);
+  std::size_t seed = 1;
+  for (kind& k : messages) {
+    seed = seed * 6364136223846793005u + 1442695040888963407u;
+    k = static_cast<kind>((seed >> 33) % Estd::enum_count<kind>());
+  }
+
+  std::set<kind> tree_muted = {kind::ping, kind::pong, kind::ack};
+  Estd::enum_set<kind> muted = {kind::ping, kind::pong, kind::ack};
+
+  double tree = time([&] {
+    std::map<kind, std::size_t> counts;
+    for (kind k : messages)
+      if (!tree_muted.count(k))
+        ++counts[k];
+    return counts[kind::hello];
+  });
+  double dense = time([&] {
+    Estd::enum_map<kind, std::size_t> counts;
+    for (kind k : messages)
+      if (!muted.contains(k))
+        ++counts[k];
+    return counts[kind::hello];
+  });
+  std::printf("%-22s %9.0f us\n%-22s %9.0f us\n", "std::map, std::set", tree, "enum_map, enum_set", dense);
+}
@@ -0,0 +1,73 @@
+// Run-time benchmark for arrays of optional handles: std::optional<T*>, which adds a bool
+// and pads it to 16 bytes, against optional<T*>, which keeps the empty state in the null
+// pointer and is 8.
+//
+// Each test sums the handles that are present in an array of 4M optionals, 3 of 4 of
+// them engaged; the array is larger than the caches, so the scan is bound by memory:
+//
+//   g++ -std=c++17 -O2 -I.. optional.cpp && ./a.out
+
+#include "optional.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <vector>
+
+namespace bench {
+
+// Runs f until 0.2 s have gone by, and returns the time per call in microseconds.
+template<typename F>
+  double time(F f)
+  {
+    using clock = std::chrono::steady_clock;
+    std::size_t sink = 0;
+    std::size_t calls = 0;
+    auto start = clock::now();
+    double elapsed;
+    do {
+      sink += f();
+      ++calls;
+      elapsed = std::chrono::duration<double>(clock::now() - start).count();
+    } while (elapsed < 0.2);
+    volatile std::size_t keep = sink;
+    (void)keep;
+    return elapsed / calls * 1e6;
+  }
+
+template<typename Optional>
+  std::size_t sum(const std::vector<Optional>& v)
+  {
+    std::size_t s = 0;
+    for (const Optional& x : v)
+      if (x)
+        s += reinterpret_cast<std::uintptr_t>(*x);
+    return s;
+  }
+
+}	// namespace bench
+
+int main()
+{
+  using namespace bench;
+
+  const std::size_t n = 1 << 22;
+  std::vector<int> objects(n);
+  std::vector<std::optional<int*>> flagged(n);
+  std::vector<Estd::optional<int*>> niche(n);
+  std::size_t seed = 1;
+  for (std::size_t i = 0; i != n; ++i) {
+    seed = seed * 6364136223846793005u + 1442695040888963407u;
+    if ((seed >> 33) % 4) {
+      flagged[i] = &objects[i];
+      niche[i] = &objects[i];
+    }
+  }
+
+  double a = time([&] { return sum(flagged); });
+  double b = time([&] { return sum(niche); });
+  std::printf("%-22s %3zu bytes %9.0f us\n%-22s %3zu bytes %9.0f us\n",
+              "std::optional<int*>", sizeof(std::optional<int*>), a,
+              "Estd::optional<int*>", sizeof(Estd::optional<int*>), b);
+}
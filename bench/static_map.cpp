@@ -0,0 +1,87 @@
+// Run-time benchmark for lookups of header names in a static_map and a std::unordered_map.
+//
+// The table holds 40 HTTP header names. Each test looks up 1M names, 90% of them in the
+// table, as a request parser does:
+//
+//   g++ -std=c++17 -O2 -I.. static_map.cpp && ./a.out
+
+#include "static_map.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace bench {
+
+constexpr std::pair<const Estd::string_ref, int> headers[] = {
+  {"accept", 0}, {"accept-charset", 1}, {"accept-encoding", 2}, {"accept-language", 3},
+  {"accept-ranges", 4}, {"age", 5}, {"allow", 6}, {"authorization", 7},
+  {"cache-control", 8}, {"connection", 9}, {"content-encoding", 10}, {"content-language", 11},
+  {"content-length", 12}, {"content-location", 13}, {"content-range", 14}, {"content-type", 15},
+  {"cookie", 16}, {"date", 17}, {"etag", 18}, {"expect", 19},
+  {"expires", 20}, {"from", 21}, {"host", 22}, {"if-match", 23},
+  {"if-modified-since", 24}, {"if-none-match", 25}, {"if-range", 26}, {"if-unmodified-since", 27},
+  {"last-modified", 28}, {"location", 29}, {"max-forwards", 30}, {"pragma", 31},
+  {"proxy-authorization", 32}, {"range", 33}, {"referer", 34}, {"retry-after", 35},
+  {"server", 36}, {"set-cookie", 37}, {"user-agent", 38}, {"vary", 39},
+};
+
+// Runs f until 0.2 s have gone by, and returns the time per call in microseconds.
+template<typename F>
+  double time(F f)
+  {
+    using clock = std::chrono::steady_clock;
+    std::size_t sink = 0;
+    std::size_t calls = 0;
+    auto start = clock::now();
+    double elapsed;
+    do {
+      sink += f();
+      ++calls;
+      elapsed = std::chrono::duration<double>(clock::now() - start).count();
+    } while (elapsed < 0.2);
+    volatile std::size_t keep = sink;
+    (void)keep;
+    return elapsed / calls * 1e6;
+  }
+
+}	// namespace bench
+
+int main()
+{
+  using namespace bench;
+
+  static const auto table = Estd::make_static_map<Estd::string_ref, int>(headers);
+  std::unordered_map<std::string, int> map;
+  for (const auto& h : headers)
+    map.emplace(h.first.str(), h.second);
+
+  const std::size_t n = 1 << 20;
+  std::vector<std::string> names(n);
+  std::size_t seed = 1;
+  for (std::string& s : names) {
+    seed = seed * 6364136223846793005u + 1442695040888963407u;
+    std::size_t r = seed >> 33;
+    s = r % 10 ? headers[r % 40].first.str() : "x-custom-" + std::to_string(r % 100);
+  }
+
+  double dynamic = time([&] {
+    std::size_t s = 0;
+    for (const std::string& name : names) {
+      auto p = map.find(name);
+      s += p == map.end() ? 0 : p->second;
+    }
+    return s;
+  });
+  double perfect = time([&] {
+    std::size_t s = 0;
+    for (const std::string& name : names) {
+      auto p = table.find(name);
+      s += p == table.end() ? 0 : p->second;
+    }
+    return s;
+  });
+  std::printf("%-14s %9.0f us\n%-14s %9.0f us\n", "unordered_map", dynamic, "static_map", perfect);
+}
@@ -0,0 +1,469 @@
+#ifndef BIT_VECTOR_H
+#define BIT_VECTOR_H
+
+#include "constraints.h"
+#include "iterator_facade.h"
+#include "memory.h"
+#include "platform.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+// bit_vector is a dynamic sequence of bits packed into 64-bit words, in the manner of
+// std::vector<bool>, but with the word-level operations that make large bitmaps cheap to
+// scan: count, find_first and find_next, the bitwise operators, and rank and select.
+// Each of these works a word at a time (or four, with AVX2; see impl/bit_words.h) instead
+// of testing one bit per step.
+//
+// Bit i is bit i % 64 of word i / 64. The bits of the last word past the size are always
+// zero, so the word operations need no special case for the tail.
+//
+// Bits are accessed through bit_reference, a proxy that reads as bool and assigns through
+// to its word. The iterators are random access, with bit_reference (or bool, for
+// const_iterator) as their reference type.
+
+namespace Estd {
+
+#include "impl/bit_words.h"
+
+// A reference to a single bit of a word.
+class bit_reference {
+public:
+  bit_reference(std::uint64_t* w, std::uint64_t mask) : w(w), mask(mask) { }
+
+  operator bool() const { return (*w & mask) != 0; }
+
+  bool operator~() const { return (*w & mask) == 0; }
+
+  bit_reference& operator=(bool b)
+  {
+    if (b)
+      *w |= mask;
+    else
+      *w &= ~mask;
+    return *this;
+  }
+
+  bit_reference& operator=(const bit_reference& x) { return *this = bool(x); }
+
+  void flip() { *w ^= mask; }
+
+private:
+  std::uint64_t* w;
+  std::uint64_t mask;
+};
+
+// Swap the bits, not the references.
+inline void swap(bit_reference a, bit_reference b)
+{
+  bool t = a;
+  a = b;
+  b = t;
+}
+
+namespace impl {
+
+template<bool Const>
+  class bit_iterator
+    : public iterator_facade<bit_iterator<Const>,
+                             bool,
+                             Conditional<Const, bool, bit_reference>,
+                             std::random_access_iterator_tag>
+  {
+    using facade = iterator_facade<bit_iterator<Const>,
+                                   bool,
+                                   Conditional<Const, bool, bit_reference>,
+                                   std::random_access_iterator_tag>;
+    friend facade;
+
+    using word = Conditional<Const, const std::uint64_t, std::uint64_t>;
+
+  public:
+    bit_iterator() : p(nullptr), i(0) { }
+
+    bit_iterator(word* p, std::size_t i) : p(p), i(i) { }
+
+    // iterator converts to const_iterator.
+    template<bool C,
+             typename = Enable_if<Const && !C>>
+      bit_iterator(const bit_iterator<C>& x)
+        : p(x.words()), i(x.index())
+      { }
+
+    word* words() const { return p; }
+    std::size_t index() const { return i; }
+
+  private:
+    typename facade::reference dereference() const { return dereference(boolean_constant<Const>{}); }
+
+    bool dereference(boolean_constant<true>) const
+    {
+      return (p[i / word_bits] >> (i % word_bits)) & 1;
+    }
+
+    bit_reference dereference(boolean_constant<false>) const
+    {
+      return bit_reference(p + i / word_bits, std::uint64_t(1) << (i % word_bits));
+    }
+
+    bool equal(const bit_iterator& x) const { return i == x.i; }
+    void increment() { ++i; }
+    void decrement() { --i; }
+    void advance(std::ptrdiff_t n) { i += n; }
+    std::ptrdiff_t distance_to(const bit_iterator& x) const { return std::ptrdiff_t(x.i - i); }
+
+    word* p;
+    std::size_t i;
+  };
+
+}	// namespace impl
+
+class bit_vector {
+  using words_type = std::vector<std::uint64_t, aligned_allocator<std::uint64_t>>;
+
+public:
+  using value_type = bool;
+  using reference = bit_reference;
+  using const_reference = bool;
+  using iterator = impl::bit_iterator<false>;
+  using const_iterator = impl::bit_iterator<true>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  bit_vector() : n(0) { }
+
+  explicit bit_vector(size_type count, bool value = false)
+    : w(impl::words_for(count), value ? ~std::uint64_t(0) : 0), n(count)
+  {
+    clear_tail();
+  }
+
+  bit_vector(std::initializer_list<bool> list)
+    : bit_vector(list.begin(), list.end())
+  { }
+
+  template<typename I,
+           typename = Enable_if<Input_iterator<I>()>>
+    bit_vector(I first, I last)
+      : n(0)
+    {
+      for (; first != last; ++first)
+        push_back(*first);
+    }
+
+  // Size and capacity
+
+  size_type size() const { return n; }
+  bool empty() const { return n == 0; }
+  size_type capacity() const { return w.capacity() * impl::word_bits; }
+
+  void reserve(size_type bits) { w.reserve(impl::words_for(bits)); }
+
+  void clear()
+  {
+    w.clear();
+    n = 0;
+  }
+
+  void resize(size_type count, bool value = false)
+  {
+    size_type old = n;
+    w.resize(impl::words_for(count), value ? ~std::uint64_t(0) : 0);
+    n = count;
+    if (value && count > old && old % impl::word_bits != 0)
+      w[old / impl::word_bits] |= ~impl::low_bits(old % impl::word_bits);
+    clear_tail();
+  }
+
+  void push_back(bool b)
+  {
+    if (n % impl::word_bits == 0)
+      w.push_back(0);
+    if (b)
+      w[n / impl::word_bits] |= std::uint64_t(1) << (n % impl::word_bits);
+    ++n;
+  }
+
+  void pop_back()
+  {
+    --n;
+    if (n % impl::word_bits == 0)
+      w.pop_back();
+    else
+      clear_tail();
+  }
+
+  void swap(bit_vector& x) noexcept
+  {
+    w.swap(x.w);
+    std::swap(n, x.n);
+  }
+
+  // Bits
+
+  reference operator[](size_type i) { return *(begin() + i); }
+  const_reference operator[](size_type i) const { return test(i); }
+
+  bool test(size_type i) const { return (w[i / impl::word_bits] >> (i % impl::word_bits)) & 1; }
+
+  bit_vector& set(size_type i, bool value = true)
+  {
+    (*this)[i] = value;
+    return *this;
+  }
+
+  bit_vector& reset(size_type i) { return set(i, false); }
+
+  bit_vector& flip(size_type i)
+  {
+    w[i / impl::word_bits] ^= std::uint64_t(1) << (i % impl::word_bits);
+    return *this;
+  }
+
+  bit_vector& set()
+  {
+    std::fill(w.begin(), w.end(), ~std::uint64_t(0));
+    clear_tail();
+    return *this;
+  }
+
+  bit_vector& reset()
+  {
+    std::fill(w.begin(), w.end(), 0);
+    return *this;
+  }
+
+  bit_vector& flip()
+  {
+    for (std::uint64_t& x : w)
+      x = ~x;
+    clear_tail();
+    return *this;
+  }
+
+  iterator begin() { return iterator(w.data(), 0); }
+  iterator end() { return iterator(w.data(), n); }
+  const_iterator begin() const { return const_iterator(w.data(), 0); }
+  const_iterator end() const { return const_iterator(w.data(), n); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  // The words, for kernels of one's own. The bits past size() are zero, and must stay so.
+  std::uint64_t* data() { return w.data(); }
+  const std::uint64_t* data() const { return w.data(); }
+  size_type word_count() const { return w.size(); }
+
+  // Queries
+
+  // The number of set bits.
+  size_type count() const { return impl::count_words(w.data(), w.size()); }
+
+  bool any() const { return impl::find_word(w.data(), 0, w.size()) != w.size(); }
+  bool none() const { return !any(); }
+
+  bool all() const
+  {
+    size_type full = n / impl::word_bits;
+    for (size_type k = 0; k != full; ++k)
+      if (w[k] != ~std::uint64_t(0))
+        return false;
+    return n % impl::word_bits == 0 || w[full] == impl::low_bits(n % impl::word_bits);
+  }
+
+  // The position of the first set bit, or size() if there is none.
+  size_type find_first() const { return find_from(0); }
+
+  // The position of the first set bit after i, or size() if there is none.
+  size_type find_next(size_type i) const
+  {
+    ++i;
+    if (i >= n)
+      return n;
+    size_type k = i / impl::word_bits;
+    std::uint64_t x = w[k] & ~impl::low_bits(i % impl::word_bits);
+    if (x)
+      return k * impl::word_bits + impl::countr_zero(x);
+    return find_from(k + 1);
+  }
+
+  // The number of set bits in [0, i), for i <= size().
+  size_type rank(size_type i) const
+  {
+    size_type k = i / impl::word_bits;
+    size_type r = impl::count_words(w.data(), k);
+    if (i % impl::word_bits)
+      r += impl::popcount(w[k] & impl::low_bits(i % impl::word_bits));
+    return r;
+  }
+
+  // The position of the set bit with k set bits before it, or size() if there are
+  // no more than k set bits. For repeated rank and select queries over an unchanging
+  // bit_vector, see rank_select_index.
+  size_type select(size_type k) const
+  {
+    for (size_type j = 0; j != w.size(); ++j) {
+      unsigned c = impl::popcount(w[j]);
+      if (k < c)
+        return j * impl::word_bits + impl::select_in_word(w[j], unsigned(k));
+      k -= c;
+    }
+    return n;
+  }
+
+  // Bitwise operations. The operands must have the same size.
+
+  bit_vector& operator&=(const bit_vector& x)
+  {
+    impl::transform_words(w.data(), x.w.data(), w.size(), impl::and_words{});
+    return *this;
+  }
+
+  bit_vector& operator|=(const bit_vector& x)
+  {
+    impl::transform_words(w.data(), x.w.data(), w.size(), impl::or_words{});
+    return *this;
+  }
+
+  bit_vector& operator^=(const bit_vector& x)
+  {
+    impl::transform_words(w.data(), x.w.data(), w.size(), impl::xor_words{});
+    return *this;
+  }
+
+  bit_vector operator~() const
+  {
+    bit_vector r(*this);
+    r.flip();
+    return r;
+  }
+
+  friend bool operator==(const bit_vector& a, const bit_vector& b)
+  {
+    return a.n == b.n && a.w == b.w;
+  }
+
+  friend bool operator!=(const bit_vector& a, const bit_vector& b)
+  {
+    return !(a == b);
+  }
+
+private:
+  // Keep the bits past the size zero.
+  void clear_tail()
+  {
+    if (n % impl::word_bits)
+      w.back() &= impl::low_bits(n % impl::word_bits);
+  }
+
+  size_type find_from(size_type k) const
+  {
+    k = impl::find_word(w.data(), k, w.size());
+    return k == w.size() ? n : k * impl::word_bits + impl::countr_zero(w[k]);
+  }
+
+  words_type w;
+  size_type n;
+};
+
+inline bit_vector operator&(bit_vector a, const bit_vector& b)
+{
+  a &= b;
+  return a;
+}
+
+inline bit_vector operator|(bit_vector a, const bit_vector& b)
+{
+  a |= b;
+  return a;
+}
+
+inline bit_vector operator^(bit_vector a, const bit_vector& b)
+{
+  a ^= b;
+  return a;
+}
+
+inline void swap(bit_vector& a, bit_vector& b) noexcept
+{
+  a.swap(b);
+}
+
+// rank_select_index answers rank and select over a bit_vector in constant and logarithmic
+// time, instead of the linear scans of bit_vector::rank and select.
+//
+// It keeps the number of set bits before each block of 8 words (512 bits, a cache line of
+// the bit_vector's aligned storage), which costs 1/8 of the bitmap. rank reads one count
+// and at most 8 words; select binary searches the counts, then scans one block. The index
+// refers to the bit_vector's words, so it is invalidated by any change to the bit_vector.
+class rank_select_index {
+  static constexpr std::size_t block_words = 8;
+  static constexpr std::size_t block_bits = block_words * impl::word_bits;
+
+public:
+  using size_type = std::size_t;
+
+  explicit rank_select_index(const bit_vector& v)
+    : w(v.data()), n(v.size()), blocks(v.word_count() / block_words + 1)
+  {
+    size_type words = v.word_count();
+    std::uint64_t r = 0;
+    for (size_type b = 0; b + 1 < blocks.size(); ++b) {
+      blocks[b] = r;
+      r += impl::count_words(w + b * block_words, block_words);
+    }
+    blocks.back() = r;
+    size_type last = (blocks.size() - 1) * block_words;
+    blocks.push_back(r + impl::count_words(w + last, words - last));
+  }
+
+  size_type size() const { return n; }
+
+  // The number of set bits.
+  size_type count() const { return blocks.back(); }
+
+  // The number of set bits in [0, i), for i <= size().
+  size_type rank(size_type i) const
+  {
+    size_type b = i / block_bits;
+    size_type k = i / impl::word_bits;
+    size_type r = blocks[b] + impl::count_words(w + b * block_words, k - b * block_words);
+    if (i % impl::word_bits)
+      r += impl::popcount(w[k] & impl::low_bits(i % impl::word_bits));
+    return r;
+  }
+
+  // The position of the set bit with k set bits before it, or size() if there are
+  // no more than k set bits.
+  size_type select(size_type k) const
+  {
+    if (k >= count())
+      return n;
+    size_type b = std::upper_bound(blocks.begin(), blocks.end(), k) - blocks.begin() - 1;
+    k -= blocks[b];
+    for (size_type j = b * block_words; ; ++j) {
+      unsigned c = impl::popcount(w[j]);
+      if (k < c)
+        return j * impl::word_bits + impl::select_in_word(w[j], unsigned(k));
+      k -= c;
+    }
+  }
+
+private:
+  const std::uint64_t* w;
+  size_type n;
+
+  // blocks[b] is the number of set bits in the words before block b; the last entry
+  // is the total.
+  std::vector<std::uint64_t> blocks;
+};
+
+}	// namespace Estd
+
+#endif	// BIT_VECTOR_H
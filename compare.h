@@ -0,0 +1,152 @@
+#ifndef COMPARE_H
+#define COMPARE_H
+
+#include "comparison.h"
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+// Three-way comparison: compare_3way(a, b) is negative if a is less than b, zero if they are
+// equivalent, and positive if a is greater than b.
+//
+// Code that has only < needs two calls to tell equal keys from unequal ones, a < b and then
+// b < a, and for strings the second call walks the same common prefix again. compare_3way
+// makes one call, choosing the first of these that applies:
+//
+//   - arithmetic values are compared directly, without a branch;
+//   - pairs and tuples are compared element by element with compare_3way, and the comparison
+//     stops at the first element that differs;
+//   - a <=> b, in C++20;
+//   - a.compare(b), which the standard strings have in every version of the language, when
+//     it returns a signed integer; a compare that returns bool, say, is not a comparison;
+//   - otherwise a < b, and then b < a if that is false.
+//
+// Only the sign of the result means anything: a.compare(b) can return any int.
+// One_call_comparable<T, U>() is true when one of the first four applies.
+
+namespace Estd {
+
+template<typename T, typename U>
+  int compare_3way(const T& a, const U& b);
+
+namespace impl {
+
+enum compare_method {
+  compare_arithmetic,
+  compare_elements,
+  compare_three_way,
+  compare_member,
+  compare_less
+};
+
+template<compare_method M>
+  using compare_method_constant = integral_constant<compare_method, M>;
+
+// Are T and U both pairs, or both tuples of the same size?
+template<typename T, typename U>
+  struct is_tuple_pair : boolean_constant<false> { };
+
+template<typename A, typename B, typename C, typename D>
+  struct is_tuple_pair<std::pair<A, B>, std::pair<C, D>> : boolean_constant<true> { };
+
+template<typename... Ts, typename... Us>
+  struct is_tuple_pair<std::tuple<Ts...>, std::tuple<Us...>>
+    : boolean_constant<sizeof...(Ts) == sizeof...(Us)> { };
+
+// The type of t.compare(u), or substitution_failure.
+template<typename T, typename U>
+  struct get_compare_member_result {
+  private:
+    template<typename X, typename Y>
+      static auto check(X&& x, Y&& y) -> decltype(x.compare(y));
+
+    static substitution_failure check(...);
+
+  public:
+    using type = decltype(check(std::declval<T>(), std::declval<U>()));
+  };
+
+// Does t.compare(u) return a signed integer, as the three-way compare of the strings does?
+template<typename T, typename U>
+  constexpr bool Has_compare_member()
+  {
+    using R = typename get_compare_member_result<T, U>::type;
+    return Integral<R>() && Signed<R>();
+  }
+
+template<typename T, typename U>
+  constexpr compare_method compare_method_of()
+  {
+    return Arithmetic<T>() && Arithmetic<U>() ? compare_arithmetic
+         : is_tuple_pair<T, U>::value ? compare_elements
+         : Comparison_category<Three_way_result<const T&, const U&>>() ? compare_three_way
+         : Has_compare_member<const T&, const U&>() ? compare_member
+         : compare_less;
+  }
+
+template<typename T, typename U>
+  inline int compare_by(const T& a, const U& b, compare_method_constant<compare_arithmetic>)
+  {
+    return int(b < a) - int(a < b);
+  }
+
+template<typename T, typename U, std::size_t N>
+  inline int compare_tuples(const T&, const U&, size_constant<N>, size_constant<N>)
+  {
+    return 0;
+  }
+
+template<typename T, typename U, std::size_t I, std::size_t N>
+  inline int compare_tuples(const T& a, const U& b, size_constant<I>, size_constant<N>)
+  {
+    int c = Estd::compare_3way(std::get<I>(a), std::get<I>(b));
+    return c != 0 ? c : compare_tuples(a, b, size_constant<I + 1>{}, size_constant<N>{});
+  }
+
+template<typename T, typename U>
+  inline int compare_by(const T& a, const U& b, compare_method_constant<compare_elements>)
+  {
+    return compare_tuples(a, b, size_constant<0>{}, size_constant<std::tuple_size<T>::value>{});
+  }
+
+#if defined(ESTD_HAS_THREE_WAY)
+template<typename T, typename U>
+  inline int compare_by(const T& a, const U& b, compare_method_constant<compare_three_way>)
+  {
+    auto c = a <=> b;
+    return int(c > 0) - int(c < 0);
+  }
+#endif
+
+template<typename T, typename U>
+  inline int compare_by(const T& a, const U& b, compare_method_constant<compare_member>)
+  {
+    return a.compare(b);
+  }
+
+template<typename T, typename U>
+  inline int compare_by(const T& a, const U& b, compare_method_constant<compare_less>)
+  {
+    static_assert(Has_less<const T&, const U&>() && Has_less<const U&, const T&>(),
+                  "compare_3way: requires values ordered by <");
+
+    return a < b ? -1 : b < a ? 1 : 0;
+  }
+
+}	// namespace impl
+
+template<typename T, typename U = T>
+  constexpr bool One_call_comparable()
+  {
+    return impl::compare_method_of<T, U>() != impl::compare_less;
+  }
+
+template<typename T, typename U>
+  inline int compare_3way(const T& a, const U& b)
+  {
+    return impl::compare_by(a, b, impl::compare_method_constant<impl::compare_method_of<T, U>()>{});
+  }
+
+}	// namespace Estd
+
+#endif	// COMPARE_H
@@ -0,0 +1,152 @@
+#ifndef COMPARISON_H
+#define COMPARISON_H
+
+#include "operators.h"
+
+// The comparison concepts - Equality_comparable, Weakly_ordered, Totally_ordered,
+// Three_way_comparable, Bitwise_comparable - and the object concepts defined with them:
+// Movable, Copyable, Semiregular, Regular and Ordered.
+
+// Can the compiler tell whether a type has padding bits?
+#if defined(__has_builtin)
+#if __has_builtin(__has_unique_object_representations)
+#define ESTD_HAS_UNIQUE_OBJECT_REPRESENTATIONS
+#endif
+#endif
+
+namespace Estd {
+
+// Forward declarations.
+namespace impl {
+
+template<typename T, typename U>
+  struct is_equality_comparable;
+
+template<typename T, typename U>
+  struct is_weakly_ordered;
+
+template<typename T, typename U>
+  struct is_three_way_comparable;
+
+}	// namespace impl
+
+template<typename T, typename U = T>
+  constexpr bool Equality_comparable()
+  {
+    return impl::is_equality_comparable<T, U>::value;
+  }
+
+template<typename T, typename U = T>
+  constexpr bool Weakly_ordered()
+  {
+    return impl::is_weakly_ordered<T, U>::value;
+  }
+
+template<typename T, typename U = T>
+  constexpr bool Totally_ordered()
+  {
+    return Weakly_ordered<T>() && Equality_comparable<T>();
+  }
+
+// Totally ordered, and t <=> u gives one of the comparison categories, consistently with
+// the other operators. Before C++20 nothing is Three_way_comparable.
+template<typename T, typename U = T>
+  constexpr bool Three_way_comparable()
+  {
+    return impl::is_three_way_comparable<T, U>::value;
+  }
+
+// Implementation of is_equality_comparable, is_weakly_ordered and is_three_way_comparable.
+#include "impl/comparable.h"
+
+// Bitwise comparison.
+//
+// Bitwise_comparable<T>() says that two T objects are equal exactly when their bytes are, so
+// that sequences of T can be compared with memcmp and hashed as bytes. It holds for integers,
+// characters, bool, enumerations and pointers, and for pairs of them without padding.
+// Floating point types are not bitwise comparable, since 0.0 == -0.0 and NaN != NaN.
+//
+// A class opts in by specializing bitwise_comparable_traits:
+//
+//   template<>
+//     struct bitwise_comparable_traits<my_record> : boolean_constant<true> { };
+//
+// This promises that my_record's == compares every byte of the object, as a memberwise ==
+// does over members that are themselves bitwise comparable. Padding bytes make the promise
+// impossible to keep, so where the compiler can detect them a type with padding is rejected.
+
+template<typename T>
+  struct bitwise_comparable_traits
+    : boolean_constant<Integral<T>() || Enum<T>() || Pointer<T>()> { };
+
+template<typename T>
+  struct bitwise_comparable_traits<const T> : bitwise_comparable_traits<T> { };
+
+template<typename T, typename U>
+  struct bitwise_comparable_traits<std::pair<T, U>>
+    : boolean_constant<bitwise_comparable_traits<T>::value
+                    && bitwise_comparable_traits<U>::value
+                    && sizeof(std::pair<T, U>) == sizeof(T) + sizeof(U)> { };
+
+namespace impl {
+
+// Is T free of padding bits? The builtin only answers for trivially copyable types, so for
+// any other type, and without the builtin, we take the user's word for it.
+template<typename T>
+  constexpr bool Unique_representation()
+  {
+#if defined(ESTD_HAS_UNIQUE_OBJECT_REPRESENTATIONS)
+    return !Trivially_copyable<T>() || __has_unique_object_representations(T);
+#else
+    return true;
+#endif
+  }
+
+}	// namespace impl
+
+template<typename T>
+  constexpr bool Bitwise_comparable()
+  {
+    static_assert(!bitwise_comparable_traits<T>::value || impl::Unique_representation<Remove_cv<T>>(),
+                  "bitwise_comparable_traits: a type with padding bytes is not bitwise comparable");
+
+    return bitwise_comparable_traits<T>::value && Equality_comparable<T>();
+  }
+
+template<typename T>
+  constexpr bool Movable()
+  {
+    return Destructible<T>()
+        && Move_constructible<T>()
+	&& Move_assignable<T>();
+  }
+
+template<typename T>
+  constexpr bool Copyable()
+  {
+    return Movable<T>()
+        && Copy_constructible<T>()
+	&& Copy_assignable<T>();
+  }
+
+template<typename T>
+  constexpr bool Semiregular()
+  {
+    return Copyable<T>() && Destructible<T>();
+  }
+
+template<typename T>
+  constexpr bool Regular()
+  {
+    return Semiregular<T>() && Equality_comparable<T>();
+  }
+
+template<typename T>
+  constexpr bool Ordered()
+  {
+    return Regular<T>() && Totally_ordered<T>();
+  }
+
+}	// namespace Estd
+
+#endif	// COMPARISON_H
@@ -0,0 +1,419 @@
+#ifndef CONCURRENT_QUEUE_H
+#define CONCURRENT_QUEUE_H
+
+#include "constraints.h"
+#include "platform.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Bounded lock-free queues.
+//
+// spsc_queue<T> has exactly one producer thread and one consumer thread.
+// mpmc_queue<T> allows any number of each; it is Dmitry Vyukov's bounded MPMC queue.
+//
+// Neither queue blocks: try_push fails when the queue is full and try_pop fails when it
+// is empty, and the caller decides whether to spin, yield or sleep. The capacity is
+// fixed at construction and rounded up to a power of two.
+//
+// The element type must be Movable, and its move constructor must not throw, because
+// an element is moved out of a slot after the slot has been claimed; there is no way
+// to give the slot back if the move fails.
+//
+// The batch operations claim several slots with one atomic operation and, for the SPSC
+// queue, publish them with one release store, which is where most of the throughput of a
+// busy queue comes from.
+//
+// The indices written by the producer and by the consumer are kept a cache line apart,
+// so the two sides don't invalidate each other's lines on every operation.
+
+namespace Estd {
+
+namespace impl {
+
+inline std::size_t queue_capacity(std::size_t n)
+{
+  std::size_t c = 2;
+  while (c < n)
+    c *= 2;
+  return c;
+}
+
+template<typename T>
+  using Queue_slot = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+}	// namespace impl
+
+// spsc_queue
+
+template<typename T>
+  class spsc_queue {
+    static_assert(Movable<T>(), "spsc_queue: T must be Movable");
+    static_assert(Nothrow_move_constructible<T>(), "spsc_queue: T must be nothrow move constructible");
+
+  public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    explicit spsc_queue(std::size_t capacity)
+      : mask(impl::queue_capacity(capacity) - 1),
+        slots(new impl::Queue_slot<T>[mask + 1]),
+        head(0), cached_tail(0),
+        tail(0), cached_head(0)
+    { }
+
+    spsc_queue(const spsc_queue&) = delete;
+    spsc_queue& operator=(const spsc_queue&) = delete;
+
+    ~spsc_queue()
+    {
+      for (std::size_t i = head.load(std::memory_order_relaxed), e = tail.load(std::memory_order_relaxed); i != e; ++i)
+        slot(i)->~T();
+    }
+
+    size_type capacity() const { return mask + 1; }
+
+    // Only exact when neither side is running.
+    size_type size() const
+    {
+      const std::size_t h = head.load(std::memory_order_acquire);
+      return tail.load(std::memory_order_acquire) - h;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    // Producer operations.
+
+    template<typename... Args>
+      bool try_emplace(Args&&... args)
+      {
+        const std::size_t t = tail.load(std::memory_order_relaxed);
+        if (free_slots(t, 1) == 0)
+          return false;
+        ::new (static_cast<void*>(slot(t))) T(std::forward<Args>(args)...);
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+      }
+
+    bool try_push(const T& x) { return try_emplace(x); }
+
+    bool try_push(T&& x) { return try_emplace(std::move(x)); }
+
+    // Push as many of [first, last) as fit, and return the first element not pushed.
+    // The elements are copied; pass move iterators to move them.
+    template<typename I>
+      I try_push(I first, I last)
+      {
+        static_assert(Input_iterator<I>(), "spsc_queue: requires input iterators");
+
+        const std::size_t t = tail.load(std::memory_order_relaxed);
+        const std::size_t n = free_slots(t, capacity());
+        std::size_t i = 0;
+        try {
+          for (; i != n && first != last; ++i, ++first)
+            ::new (static_cast<void*>(slot(t + i))) T(*first);
+        }
+        catch (...) {
+          tail.store(t + i, std::memory_order_release);
+          throw;
+        }
+        tail.store(t + i, std::memory_order_release);
+        return first;
+      }
+
+    // Consumer operations.
+
+    bool try_pop(T& x)
+    {
+      const std::size_t h = head.load(std::memory_order_relaxed);
+      if (used_slots(h, 1) == 0)
+        return false;
+      T* p = slot(h);
+      x = std::move(*p);
+      p->~T();
+      head.store(h + 1, std::memory_order_release);
+      return true;
+    }
+
+    // Pop up to n elements into out, and return the number popped. Each element is moved
+    // out of its slot before it is assigned to out, so if that assignment throws, the
+    // element is lost but the slots popped so far are handed back.
+    template<typename O>
+      std::size_t try_pop(O out, std::size_t n)
+      {
+        const std::size_t h = head.load(std::memory_order_relaxed);
+        const std::size_t m = used_slots(h, n);
+        std::size_t i = 0;
+        try {
+          for (; i != m; ++out) {
+            T* p = slot(h + i);
+            T x(std::move(*p));
+            p->~T();
+            ++i;
+            *out = std::move(x);
+          }
+        }
+        catch (...) {
+          head.store(h + i, std::memory_order_release);
+          throw;
+        }
+        head.store(h + m, std::memory_order_release);
+        return m;
+      }
+
+  private:
+    T* slot(std::size_t i) const
+    {
+      return reinterpret_cast<T*>(&slots[i & mask]);
+    }
+
+    // The number of free slots after t, up to want. Only reloads the consumer's index
+    // when the cached copy says there isn't enough room.
+    std::size_t free_slots(std::size_t t, std::size_t want)
+    {
+      std::size_t n = capacity() - (t - cached_head);
+      if (n < want) {
+        cached_head = head.load(std::memory_order_acquire);
+        n = capacity() - (t - cached_head);
+      }
+      return n < want ? n : want;
+    }
+
+    // The number of filled slots from h on, up to want.
+    std::size_t used_slots(std::size_t h, std::size_t want)
+    {
+      std::size_t n = cached_tail - h;
+      if (n < want) {
+        cached_tail = tail.load(std::memory_order_acquire);
+        n = cached_tail - h;
+      }
+      return n < want ? n : want;
+    }
+
+    // Shared and read-only.
+    const std::size_t mask;
+    const std::unique_ptr<impl::Queue_slot<T>[]> slots;
+
+    // Written by the consumer.
+    alignas(cache_line_size) std::atomic<std::size_t> head;
+    std::size_t cached_tail;
+
+    // Written by the producer.
+    alignas(cache_line_size) std::atomic<std::size_t> tail;
+    std::size_t cached_head;
+  };
+
+// mpmc_queue
+//
+// Each slot carries a sequence number. A slot at position p is free for the producer that
+// claims p when its sequence is p, and full for the consumer that claims p when its sequence
+// is p + 1. Producers and consumers claim positions by advancing their index with a CAS,
+// and hand a slot over by storing the next sequence number with release semantics.
+
+template<typename T>
+  class mpmc_queue {
+    static_assert(Movable<T>(), "mpmc_queue: T must be Movable");
+    static_assert(Nothrow_move_constructible<T>(), "mpmc_queue: T must be nothrow move constructible");
+
+    struct cell {
+      std::atomic<std::size_t> sequence;
+      impl::Queue_slot<T> storage;
+
+      T* value() { return reinterpret_cast<T*>(&storage); }
+    };
+
+  public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    explicit mpmc_queue(std::size_t capacity)
+      : mask(impl::queue_capacity(capacity) - 1),
+        cells(new cell[mask + 1]),
+        enqueue_pos(0),
+        dequeue_pos(0)
+    {
+      for (std::size_t i = 0; i != mask + 1; ++i)
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    mpmc_queue(const mpmc_queue&) = delete;
+    mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+    ~mpmc_queue()
+    {
+      for (std::size_t i = dequeue_pos.load(std::memory_order_relaxed), e = enqueue_pos.load(std::memory_order_relaxed); i != e; ++i)
+        cells[i & mask].value()->~T();
+    }
+
+    size_type capacity() const { return mask + 1; }
+
+    // Only exact when no thread is running.
+    size_type size() const
+    {
+      const std::size_t h = dequeue_pos.load(std::memory_order_acquire);
+      return enqueue_pos.load(std::memory_order_acquire) - h;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    template<typename... Args>
+      bool try_emplace(Args&&... args)
+      {
+        return emplace(boolean_constant<Nothrow_constructible<T, Args...>()>{}, std::forward<Args>(args)...);
+      }
+
+    bool try_push(const T& x) { return try_emplace(x); }
+
+    bool try_push(T&& x) { return try_emplace(std::move(x)); }
+
+    // Push as many of [first, last) as fit in one claim, and return the first element not pushed.
+    // The elements are copied; pass move iterators to move them. When that copy can throw, the
+    // elements are pushed one at a time instead, each made before its slot is claimed.
+    template<typename I>
+      I try_push(I first, I last)
+      {
+        static_assert(Forward_iterator<I>(), "mpmc_queue: requires forward iterators");
+
+        return push(boolean_constant<Nothrow_constructible<T, Dereference_result<I>>()>{}, first, last);
+      }
+
+    bool try_pop(T& x)
+    {
+      std::size_t pos;
+      if (claim(dequeue_pos, 1, 1, pos) == 0)
+        return false;
+      x = release(pos);
+      return true;
+    }
+
+    // Pop up to n elements into out, and return the number popped. If assigning an element
+    // to out throws, that element and the rest of those claimed are lost, but their cells
+    // are still handed back to the producers.
+    template<typename O>
+      std::size_t try_pop(O out, std::size_t n)
+      {
+        std::size_t pos;
+        std::size_t m = claim(dequeue_pos, 1, n, pos);
+        std::size_t i = 0;
+        try {
+          for (; i != m; ++out) {
+            T x = release(pos + i);
+            ++i;
+            *out = std::move(x);
+          }
+        }
+        catch (...) {
+          for (; i != m; ++i)
+            release(pos + i);
+          throw;
+        }
+        return m;
+      }
+
+  private:
+    // A claimed slot has to be filled, so a constructor that can throw runs before the claim,
+    // and the element is then moved in, which can't throw.
+    template<typename... Args>
+      bool emplace(boolean_constant<false>, Args&&... args)
+      {
+        T x(std::forward<Args>(args)...);
+        return emplace(boolean_constant<true>{}, std::move(x));
+      }
+
+    template<typename... Args>
+      bool emplace(boolean_constant<true>, Args&&... args)
+      {
+        std::size_t pos;
+        if (claim(enqueue_pos, 0, 1, pos) == 0)
+          return false;
+        cell& c = cells[pos & mask];
+        ::new (static_cast<void*>(&c.storage)) T(std::forward<Args>(args)...);
+        c.sequence.store(pos + 1, std::memory_order_release);
+        return true;
+      }
+
+    template<typename I>
+      I push(boolean_constant<false>, I first, I last)
+      {
+        while (first != last && try_emplace(*first))
+          ++first;
+        return first;
+      }
+
+    template<typename I>
+      I push(boolean_constant<true>, I first, I last)
+      {
+        std::size_t want = std::distance(first, last);
+        std::size_t pos;
+        std::size_t n = claim(enqueue_pos, 0, want, pos);
+        for (std::size_t i = 0; i != n; ++i, ++first) {
+          cell& c = cells[(pos + i) & mask];
+          ::new (static_cast<void*>(&c.storage)) T(*first);
+          c.sequence.store(pos + i + 1, std::memory_order_release);
+        }
+        return first;
+      }
+
+    // Claim up to want consecutive positions from index, whose cells must have the sequence
+    // position + lag: 0 for producers, 1 for consumers. Returns the number claimed and the
+    // first claimed position in pos.
+    //
+    // Checking a cell before the CAS is safe: only the thread that owns position p can change
+    // the sequence of a cell that is ready for p, and nobody owns p until the CAS succeeds.
+    std::size_t claim(std::atomic<std::size_t>& index, std::size_t lag, std::size_t want, std::size_t& pos)
+    {
+      pos = index.load(std::memory_order_relaxed);
+      for (;;) {
+        std::size_t n = 0;
+        for (; n != want; ++n) {
+          std::size_t seq = cells[(pos + n) & mask].sequence.load(std::memory_order_acquire);
+          if (seq != pos + n + lag)
+            break;
+        }
+
+        if (n != 0) {
+          if (index.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed))
+            return n;
+          continue;
+        }
+
+        // The first cell isn't ready. Either the queue is full (empty for consumers),
+        // or another thread claimed pos and we must catch up.
+        std::size_t seq = cells[pos & mask].sequence.load(std::memory_order_acquire);
+        std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + lag);
+        if (diff < 0)
+          return 0;
+        if (diff == 0)
+          continue;
+        pos = index.load(std::memory_order_relaxed);
+      }
+    }
+
+    // Move the element at pos out and hand the cell to the producer of the next lap. The
+    // move can't throw, so the cell is handed back whatever the caller then does with the
+    // element.
+    T release(std::size_t pos)
+    {
+      cell& c = cells[pos & mask];
+      T* p = c.value();
+      T x(std::move(*p));
+      p->~T();
+      c.sequence.store(pos + mask + 1, std::memory_order_release);
+      return x;
+    }
+
+    // Shared and read-only.
+    const std::size_t mask;
+    const std::unique_ptr<cell[]> cells;
+
+    alignas(cache_line_size) std::atomic<std::size_t> enqueue_pos;
+    alignas(cache_line_size) std::atomic<std::size_t> dequeue_pos;
+  };
+
+}	// namespace Estd
+
+#endif	// CONCURRENT_QUEUE_H
@@ -0,0 +1,403 @@
+#ifndef CONTAINER_TRAITS_H
+#define CONTAINER_TRAITS_H
+
+#include "operators.h"
+
+// The associated types of containers and iterators (Associated_value_type<T>,
+// Has_member_size<T>(), ...), and the deduced associated types built on them:
+// Value_type, Size_type, Difference_type, Reference_of and Pointer_of, with their
+// customization points.
+
+namespace Estd {
+
+// Container support.
+#include "impl/container.h"
+
+template<typename T>
+  using Associated_value_type = typename impl::get_associated_value_type<T>::type;
+
+template<typename T>
+  constexpr bool Has_associated_value_type()
+  {
+    return Substitution_succeeded<Associated_value_type<T>>();
+  }
+
+template<typename T>
+  using Associated_allocator_type = typename impl::get_associated_allocator_type<T>::type;
+
+template<typename T>
+  constexpr bool Has_associated_allocator_type()
+  {
+    return Substitution_succeeded<Associated_allocator_type<T>>();
+  }
+
+template<typename T>
+  using Associated_size_type = typename impl::get_associated_size_type<T>::type;
+
+template<typename T>
+  constexpr bool Has_associated_size_type()
+  {
+    return Substitution_succeeded<Associated_size_type<T>>();
+  }
+
+template<typename T>
+  using Associated_difference_type = typename impl::get_associated_difference_type<T>::type;
+
+template<typename T>
+  constexpr bool Has_associated_difference_type()
+  {
+    return Substitution_succeeded<Associated_difference_type<T>>();
+  }
+
+template<typename T>
+  using Associated_iterator = typename impl::get_associated_iterator<T>::type;
+
+template<typename T>
+  constexpr bool Has_associated_iterator()
+  {
+    return Substitution_succeeded<Associated_iterator<T>>();
+  }
+
+template<typename T>
+  using Associated_const_iterator = typename impl::get_associated_const_iterator<T>::type;
+
+template<typename T>
+  constexpr bool Has_associated_const_iterator()
+  {
+    return Substitution_succeeded<Associated_const_iterator<T>>();
+  }
+
+template<typename T>
+  using Associated_reverse_iterator = typename impl::get_associated_reverse_iterator<T>::type;
+
+template<typename T>
+  constexpr bool Has_associated_reverse_iterator()
+  {
+    return Substitution_succeeded<Associated_reverse_iterator<T>>();
+  }
+
+template<typename T>
+  using Associated_const_reverse_iterator = typename impl::get_associated_const_reverse_iterator<T>::type;
+
+template<typename T>
+  constexpr bool Has_associated_const_reverse_iterator()
+  {
+    return Substitution_succeeded<Associated_const_reverse_iterator<T>>();
+  }
+
+template<typename T>
+  using Associated_reference = typename impl::get_associated_reference<T>::type;
+
+template<typename T>
+  constexpr bool Has_associated_reference()
+  {
+    return Substitution_succeeded<Associated_reference<T>>();
+  }
+
+template<typename T>
+  using Associated_const_reference = typename impl::get_associated_const_reference<T>::type;
+
+template<typename T>
+  constexpr bool Has_associated_const_reference()
+  {
+    return Substitution_succeeded<Associated_const_reference<T>>();
+  }
+
+template<typename T>
+  using Associated_pointer = typename impl::get_associated_pointer<T>::type;
+
+template<typename T>
+  constexpr bool Has_associated_pointer()
+  {
+    return Substitution_succeeded<Associated_pointer<T>>();
+  }
+
+template<typename T>
+  using Associated_const_pointer = typename impl::get_associated_const_pointer<T>::type;
+
+template<typename T>
+  constexpr bool Has_associated_const_pointer()
+  {
+    return Substitution_succeeded<Associated_const_pointer<T>>();
+  }
+
+template<typename T>
+  using Associated_key_type = typename impl::get_associated_key_type<T>::type;
+
+template<typename T>
+  constexpr bool Has_associated_key_type()
+  {
+    return Substitution_succeeded<Associated_key_type<T>>();
+  }
+
+template<typename T>
+  using Associated_mapped_type = typename impl::get_associated_mapped_type<T>::type;
+
+template<typename T>
+  constexpr bool Has_associated_mapped_type()
+  {
+    return Substitution_succeeded<Associated_mapped_type<T>>();
+  }
+
+template<typename T>
+  using Associated_key_compare = typename impl::get_associated_key_compare<T>::type;
+
+template<typename T>
+  constexpr bool Has_associated_key_compare()
+  {
+    return Substitution_succeeded<Associated_key_compare<T>>();
+  }
+
+template<typename T>
+  using Associated_hasher = typename impl::get_associated_hasher<T>::type;
+
+template<typename T>
+  constexpr bool Has_associated_hasher()
+  {
+    return Substitution_succeeded<Associated_hasher<T>>();
+  }
+
+template<typename T>
+  using Associated_key_equal = typename impl::get_associated_key_equal<T>::type;
+
+template<typename T>
+  constexpr bool Has_associated_key_equal()
+  {
+    return Substitution_succeeded<Associated_key_equal<T>>();
+  }
+
+template<typename T>
+  using Associated_local_iterator = typename impl::get_associated_local_iterator<T>::type;
+
+template<typename T>
+  constexpr bool Has_associated_local_iterator()
+  {
+    return Substitution_succeeded<Associated_local_iterator<T>>();
+  }
+
+template<typename T>
+  using Associated_const_local_iterator = typename impl::get_associated_const_local_iterator<T>::type;
+
+template<typename T>
+  constexpr bool Has_associated_const_local_iterator()
+  {
+    return Substitution_succeeded<Associated_const_local_iterator<T>>();
+  }
+
+template<typename T>
+  using Member_size_result = typename impl::get_member_size_result<T>::type;
+
+template<typename T>
+  constexpr bool Has_member_size()
+  {
+    return Substitution_succeeded<Member_size_result<T>>();
+  }
+
+template<typename T>
+  constexpr bool Has_member_empty()
+  {
+    return impl::has_member_empty<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Has_member_max_size()
+  {
+    return impl::has_member_max_size<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Has_member_capacity()
+  {
+    return impl::has_member_capacity<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Has_member_reserve()
+  {
+    return impl::has_member_reserve<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Has_member_resize()
+  {
+    return impl::has_member_resize<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Has_member_shrink_to_fit()
+  {
+    return impl::has_member_shrink_to_fit<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Has_member_clear()
+  {
+    return impl::has_member_clear<T>::value;
+  }
+
+template<typename T>
+  using Member_front = typename impl::get_member_front_result<T>::type;
+
+template<typename T>
+  constexpr bool Has_member_front()
+  {
+    return Substitution_succeeded<Member_front<T>>();
+  }
+
+template<typename T>
+  using Member_back = typename impl::get_member_back_result<T>::type;
+
+template<typename T>
+  constexpr bool Has_member_back()
+  {
+    return Substitution_succeeded<Member_back<T>>();
+  }
+
+template<typename T>
+  using Member_at = typename impl::get_member_at_result<T>::type;
+
+template<typename T>
+  constexpr bool Has_member_at()
+  {
+    return Substitution_succeeded<Member_at<T>>();
+  }
+
+template<typename T>
+  using Member_data = typename impl::get_member_data_result<T>::type;
+
+template<typename T>
+  constexpr bool Has_member_data()
+  {
+    return Substitution_succeeded<Member_data<T>>();
+  }
+
+// Forward declaration.
+template<typename T>
+  struct difference_type_traits;
+
+template<typename T>
+  using Difference_type = typename difference_type_traits<T>::type;
+
+template<typename T>
+  constexpr bool Has_difference_type()
+  {
+    return Substitution_succeeded<Difference_type<T>>();
+  }
+
+// Traits which include type deduction for cases in which associated types are not defined.
+#include "impl/one_size_up.h"		// utitlity - get a type of next larger size.
+#include "impl/deduced_types.h"
+
+// Customization points.
+//
+// Each associated type is looked up through a traits class. The primary template takes the
+// associated member type if there is one, and otherwise deduces the type by overload resolution
+// over the deduce_X() functions in impl/deduced_types.h, together with any overloads a user
+// provides for their own types, found by ADL.
+//
+// A user who specializes the traits class for a type bypasses the deduction mechanism: the
+// specialization is found by direct lookup, and the deduce_X() overload set is never
+// considered for that type. This is the cheaper extension point when there are many
+// user types, since every overload a user adds is another candidate in every deduction.
+//
+//   template<>
+//     struct value_type_traits<my_iterator> {
+//       using type = my_value;
+//     };
+//
+// The value, size and difference types don't depend on how the type is qualified, so the
+// traits for const T, T& and T&& are those for T, and one specialization covers them all.
+// The reference and pointer types do depend on the constness of T, so reference_type_traits
+// and pointer_type_traits are specialized for each qualified type that needs one.
+
+template<typename T>
+  struct difference_type_traits {
+    using type = typename impl::get_deduced_difference_type<T>::type;
+  };
+
+template<typename T>
+  struct difference_type_traits<const T> : difference_type_traits<T> { };
+
+template<typename T>
+  struct difference_type_traits<T&> : difference_type_traits<T> { };
+
+template<typename T>
+  struct difference_type_traits<T&&> : difference_type_traits<T> { };
+
+template<typename T>
+  struct value_type_traits {
+    using type = typename impl::get_deduced_value_type<T>::type;
+  };
+
+template<typename T>
+  struct value_type_traits<const T> : value_type_traits<T> { };
+
+template<typename T>
+  struct value_type_traits<T&> : value_type_traits<T> { };
+
+template<typename T>
+  struct value_type_traits<T&&> : value_type_traits<T> { };
+
+template<typename T>
+  struct size_type_traits {
+    using type = typename impl::get_deduced_size_type<T>::type;
+  };
+
+template<typename T>
+  struct size_type_traits<const T> : size_type_traits<T> { };
+
+template<typename T>
+  struct size_type_traits<T&> : size_type_traits<T> { };
+
+template<typename T>
+  struct size_type_traits<T&&> : size_type_traits<T> { };
+
+template<typename T>
+  struct reference_type_traits {
+    using type = typename impl::get_deduced_reference<T>::type;
+  };
+
+template<typename T>
+  struct pointer_type_traits {
+    using type = typename impl::get_deduced_pointer<T>::type;
+  };
+
+template<typename T>
+  using Reference_of = typename reference_type_traits<T>::type;
+
+template<typename T>
+  constexpr bool Has_reference()
+  {
+    return Substitution_succeeded<Reference_of<T>>();
+  }
+
+template<typename T>
+  using Size_type = typename size_type_traits<T>::type;
+
+template<typename T>
+  constexpr bool Has_size_type()
+  {
+    return Substitution_succeeded<Size_type<T>>();
+  }
+
+template<typename T>
+  using Value_type = typename value_type_traits<T>::type;
+
+template<typename T>
+  constexpr bool Has_value_type()
+  {
+    return Substitution_succeeded<Value_type<T>>();
+  }
+
+template<typename T>
+  using Pointer_of = typename pointer_type_traits<T>::type;
+
+template<typename T>
+  constexpr bool Has_pointer()
+  {
+    return Substitution_succeeded<Pointer_of<T>>();
+  }
+
+}	// namespace Estd
+
+#endif	// CONTAINER_TRAITS_H
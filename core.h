@@ -0,0 +1,656 @@
+#ifndef CORE_H
+#define CORE_H
+
+#include "default_t.h"
+#include "meta_support.h"
+#include <type_traits>
+#include <utility>
+
+// The core of the library: the type predicates, the type generators, common types and
+// references, the callable traits, and the concepts built from nothing else (Common, Boolean,
+// Predicate). It needs only <type_traits> and <utility>.
+
+namespace Estd {
+
+// Primary type predicates - pp. 1018-1019
+
+template<typename T>
+  constexpr bool Void()
+  {
+    return std::is_void<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Integral()
+  {
+    return std::is_integral<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Floating_point()
+  {
+    return std::is_floating_point<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Array()
+  {
+    return std::is_array<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Pointer()
+  {
+    return std::is_pointer<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Lvalue_reference()
+  {
+    return std::is_lvalue_reference<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Rvalue_reference()
+  {
+    return std::is_rvalue_reference<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Member_object_pointer()
+  {
+    return std::is_member_object_pointer<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Member_function_pointer()
+  {
+    return std::is_member_function_pointer<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Enum()
+  {
+    return std::is_enum<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Union()
+  {
+    return std::is_union<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Class()
+  {
+    return std::is_class<T>::value;
+  }
+
+// We use Function_type() here so that we may reserve Function() for another concept.
+template<typename T>
+  constexpr bool Function_type()
+  {
+    return std::is_function<T>::value;
+  }
+
+// Composite type predicates - pg. 1019
+
+template<typename T>
+  constexpr bool Reference()
+  {
+    return std::is_reference<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Arithmetic()
+  {
+    return std::is_arithmetic<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Fundamental()
+  {
+    return std::is_fundamental<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Object()
+  {
+    return std::is_object<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Scalar()
+  {
+    return std::is_scalar<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Compound()
+  {
+    return std::is_compound<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Member_pointer()
+  {
+    return std::is_member_pointer<T>::value;
+  }
+
+// Type property predicates - pp. 1020-1022
+
+template<typename T>
+  constexpr bool Const()
+  {
+    return std::is_const<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Volatile()
+  {
+    return std::is_volatile<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Trivial()
+  {
+    return std::is_trivial<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Trivially_copyable()
+  {
+    return std::is_trivially_copyable<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Standard_layout()
+  {
+    return std::is_standard_layout<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Pod()
+  {
+    return std::is_pod<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Literal_type()
+  {
+    return std::is_literal_type<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Empty()
+  {
+    return std::is_empty<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Polymorphic()
+  {
+    return std::is_polymorphic<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Abstract()
+  {
+    return std::is_abstract<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Signed()
+  {
+    return std::is_signed<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Unsigned()
+  {
+    return std::is_unsigned<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Constructible()
+  {
+    return std::is_constructible<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Default_constructible()
+  {
+    return std::is_default_constructible<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Copy_constructible()
+  {
+    return std::is_copy_constructible<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Move_constructible()
+  {
+    return std::is_move_constructible<T>::value;
+  }
+
+template<typename T, typename U>
+  constexpr bool Assignable()
+  {
+    return std::is_assignable<T, U>::value;
+  }
+
+template<typename T>
+  constexpr bool Copy_assignable()
+  {
+    return std::is_copy_assignable<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Move_assignable()
+  {
+    return std::is_move_assignable<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Destructible()
+  {
+    return std::is_destructible<T>::value;
+  }
+
+template<typename T, typename... Args>
+  constexpr bool Trivially_constructible()
+  {
+    return std::is_trivially_constructible<T, Args...>::value;
+  }
+
+template<typename T>
+  constexpr bool Trivially_default_constructible()
+  {
+    return std::is_trivially_default_constructible<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Trivially_copy_constructible()
+  {
+    return std::is_trivially_copy_constructible<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Trivially_move_constructible()
+  {
+    return std::is_trivially_move_constructible<T>::value;
+  }
+
+template<typename T, typename U>
+  constexpr bool Trivially_assignable()
+  {
+    return std::is_trivially_assignable<T, U>::value;
+  }
+
+template<typename T>
+  constexpr bool Trivially_copy_assignable()
+  {
+    return std::is_trivially_copy_assignable<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Trivially_move_assignable()
+  {
+    return std::is_trivially_move_assignable<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Trivially_destructible()
+  {
+    return std::is_trivially_destructible<T>::value;
+  }
+
+template<typename T, typename... Args>
+  constexpr bool Nothrow_constructible()
+  {
+    return std::is_nothrow_constructible<T, Args...>::value;
+  }
+
+template<typename T>
+  constexpr bool Nothrow_default_constructible()
+  {
+    return std::is_nothrow_default_constructible<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Nothrow_copy_constructible()
+  {
+    return std::is_nothrow_copy_constructible<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Nothrow_move_constructible()
+  {
+    return std::is_nothrow_move_constructible<T>::value;
+  }
+
+template<typename T, typename U>
+  constexpr bool Nothrow_assignable()
+  {
+    return std::is_nothrow_assignable<T, U>::value;
+  }
+
+template<typename T>
+  constexpr bool Nothrow_copy_assignable()
+  {
+    return std::is_nothrow_copy_constructible<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Nothrow_move_assignable()
+  {
+    return std::is_nothrow_move_assignable<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Nothrow_destructible()
+  {
+    return std::is_nothrow_destructible<T>::value;
+  }
+
+template<typename T>
+  constexpr bool Has_virtual_destructor()
+  {
+    return std::has_virtual_destructor<T>::value;
+  }
+
+// Type property queries - pg. 1022
+
+template<typename T>
+  constexpr unsigned Alignment_of()
+  {
+    return std::alignment_of<T>::value;
+  }
+
+template<typename T>
+  constexpr unsigned Rank()
+  {
+    return std::rank<T>::value;
+  }
+
+template<typename T, unsigned N = 0>
+  constexpr unsigned Extent()
+  {
+    return std::extent<T, N>::value;
+  }
+
+template<typename T, typename U>
+  constexpr bool Same()
+  {
+    return std::is_same<T, U>::value;
+  }
+
+template<typename T, typename U>
+  constexpr bool Base_of()
+  {
+    return std::is_base_of<T, U>::value;
+  }
+
+// Extension from Origin.
+template<typename T, typename U>
+  constexpr bool Derived()
+  {
+    return std::is_base_of<U, T>::value;
+  }
+
+template<typename T, typename U>
+  constexpr bool Convertible()
+  {
+    return std::is_convertible<T, U>::value;
+  }
+
+// Type generators - pg 1023-1025
+
+template<typename T>
+  using Remove_const = typename std::remove_const<T>::type;
+
+template<typename T>
+  using Remove_volatile = typename std::remove_volatile<T>::type;
+
+template<typename T>
+  using Remove_cv = typename std::remove_cv<T>::type;
+
+template<typename T>
+  using Add_const = typename std::add_const<T>::type;
+
+template<typename T>
+  using Add_volatile = typename std::add_volatile<T>::type;
+
+template<typename T>
+  using Add_cv = typename std::add_cv<T>::type;
+
+template<typename T>
+  using Remove_reference = typename std::remove_reference<T>::type;
+
+template<typename T>
+  using Add_lvalue_reference = typename std::add_lvalue_reference<T>::type;
+
+template<typename T>
+  using Add_rvalue_reference = typename std::add_rvalue_reference<T>::type;
+
+// Origin workaround that makes sure that adding a reference to void gives substitution_failure.
+namespace impl {
+
+template<typename T>
+  struct require_lvalue_reference
+    : std::add_lvalue_reference<T> { };
+
+template<>
+  struct require_lvalue_reference<void> {
+    using type = substitution_failure;
+  };
+
+template<typename T>
+  struct require_rvalue_reference
+    : std::add_rvalue_reference<T> { };
+
+template<>
+  struct require_rvalue_reference<void> {
+    using type = substitution_failure;
+  };
+
+}	// namespace impl
+
+template<typename T>
+  using Require_lvalue_reference = typename impl::require_lvalue_reference<T>::type;
+
+template<typename T>
+  using Require_rvalue_reference = typename impl::require_rvalue_reference<T>::type;
+
+template<typename T>
+  using Decay = typename std::decay<T>::type;
+
+// This is a workaround from Origin to make sure that Make_signed and Make_unsigned
+// return substitution_failure if T is not an integral type.
+
+namespace impl {
+
+template<typename T,
+         bool = Integral<T>()>
+  struct make_signed
+    : std::make_signed<T> { };
+
+template<typename T>
+  struct make_signed<T, false> {
+    using type = substitution_failure;
+  };
+
+template<typename T,
+         bool = Integral<T>()>
+  struct make_unsigned
+    : std::make_unsigned<T> { };
+
+template<typename T>
+  struct make_unsigned<T, false> {
+    using type = substitution_failure;
+  };
+
+}	// namespace impl
+
+template<typename T>
+  using Make_signed = typename impl::make_signed<T>::type;
+
+template<typename T>
+  using Make_unsigned = typename impl::make_unsigned<T>::type;
+
+template<typename T>
+  using Remove_extent = typename std::remove_extent<T>::type;
+
+template<typename T>
+  using Remove_all_extents = typename std::remove_all_extents<T>::type;
+
+template<typename T>
+  using Remove_pointer = typename std::remove_pointer<T>::type;
+
+template<typename T>
+  using Add_pointer = typename std::add_pointer<T>::type;
+
+// TODO: Alignments.
+
+template<bool B, typename T = void>
+  using Enable_if = typename std::enable_if<B, T>::type;
+
+template<bool B, typename T, typename F>
+  using Conditional = typename std::conditional<B, T, F>::type;
+
+// The common type of Args, as std::common_type defines it for each pair, or substitution_failure
+// if there is none. Both fold the pairs from left to right, and so give the same answer
+// even where the common type isn't associative: D1*, D2*, B*, with D1 and D2 derived from B,
+// have none, since D1* and D2* have none. std::common_type recurses once per argument;
+// Common_type uses Fold, which nests its instantiations to logarithmic depth.
+
+namespace impl {
+
+template<typename T, typename U>
+  struct common_type_pair {
+  private:
+    template<typename X, typename Y>
+      static typename std::common_type<X, Y>::type check(int);
+
+    template<typename X, typename Y>
+      static substitution_failure check(...);
+
+  public:
+    using type = decltype(check<T, U>(0));
+  };
+
+template<typename T>
+  struct common_type_pair<T, substitution_failure> {
+    using type = substitution_failure;
+  };
+
+template<typename U>
+  struct common_type_pair<substitution_failure, U> {
+    using type = substitution_failure;
+  };
+
+template<>
+  struct common_type_pair<substitution_failure, substitution_failure> {
+    using type = substitution_failure;
+  };
+
+template<typename... Args>
+  struct common_type_of {
+    using type = Fold<common_type_pair, type_list<Args...>>;
+  };
+
+template<typename T, typename U>
+  struct common_type_of<T, U>
+    : common_type_pair<T, U> { };
+
+// The common type of one type is its decayed form; of none, there is none.
+template<typename T>
+  struct common_type_of<T> {
+    using type = typename std::common_type<T>::type;
+  };
+
+template<>
+  struct common_type_of<> {
+    using type = substitution_failure;
+  };
+
+}	// namespace impl
+
+template<typename... Args>
+  using Common_type = typename impl::common_type_of<Args...>::type;
+
+// The common reference of T and U is a type both convert to, and keeps references where
+// Common_type would copy. See impl/common_reference.h.
+//
+// A user whose proxy reference type P shares no such type with its value type V specializes
+// basic_common_reference<P, V> and basic_common_reference<V, P>, with a member type.
+template<typename T, typename U>
+  struct basic_common_reference { };
+
+#include "impl/common_reference.h"
+
+template<typename T, typename U>
+  using Common_reference = typename impl::get_common_reference<T, U>::type;
+
+template<typename T, typename U>
+  constexpr bool Has_common_reference()
+  {
+    return Substitution_succeeded<Common_reference<T, U>>();
+  }
+
+template<typename T>
+  using Underlying_type = typename std::underlying_type<T>::type;
+
+// I can't seem to get std::result_of in GCC to work correctly.
+// I don't know if this is due to an error in my understanding, or in the implementation.
+// I'm using Origin's implementation instead.
+#include "impl/result_of.h"
+
+// Result_of - C stands for callable type.
+template<typename C>
+  using Result_of = typename impl::result_of<C>::type;
+
+template<typename F, typename... Args>
+  constexpr bool Has_call()
+  {
+    return impl::has_call<F(Args...)>::value;
+  }
+
+// Core concepts
+
+template<typename... Args>
+  constexpr bool Common()
+  {
+    return Substitution_succeeded<Common_type<Args...>>();
+  }
+
+// T and U share a common reference, and both convert to it.
+template<typename T, typename U>
+  constexpr bool Common_reference_with()
+  {
+    return Has_common_reference<T, U>()
+        && Has_common_reference<U, T>()
+	&& Same<Common_reference<T, U>, Common_reference<U, T>>()
+	&& Convertible<T, Common_reference<T, U>>()
+	&& Convertible<U, Common_reference<T, U>>();
+  }
+
+template<typename T>
+  constexpr bool Boolean()
+  {
+    return Convertible<T, bool>();
+  }
+
+template<typename F, typename... Args>
+  constexpr bool Predicate()
+  {
+    return Copy_constructible<F>()
+        && Has_call<F, Args...>()
+	&& Boolean<Result_of<F(Args...)>>();
+  }
+
+}	// namespace Estd
+
+#endif	// CORE_H
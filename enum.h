@@ -0,0 +1,499 @@
+#ifndef ENUM_H
+#define ENUM_H
+
+#include "constraints.h"
+#include "iterator_facade.h"
+#include "niche.h"
+#include "platform.h"
+#include "static_map.h"
+#include "string_ref.h"
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+// Names for the enumerators of an enumeration, and containers indexed by enumerator.
+//
+// C++ can't list the enumerators of an enumeration, so a reflected enumeration declares
+// them with ESTD_ENUM, at namespace scope:
+//
+//   ESTD_ENUM(color, std::uint8_t, red, green, blue);
+//
+// declares enum class color : std::uint8_t { red, green, blue }, and records the names of
+// its enumerators for the functions below. ESTD_ENUM_NAMES(color, red, green, blue) does
+// the second half for an enumeration declared elsewhere, in the same namespace as the
+// enumeration. Either way the enumerators take the values 0 to N - 1, in order, so they
+// are given without initializers.
+//
+// For a reflected enumeration E:
+//   enum_count<E>()             - N, the number of enumerators
+//   enum_index(e)               - the value of e, as a std::size_t
+//   enum_name(e)                - the name of e, as a string_ref, or "" for a value that
+//                                 isn't an enumerator
+//   enum_value<E>(s)            - the enumerator named s, or std::invalid_argument
+//   enum_value(s, e)            - assigns the enumerator named s to e, or returns false
+//
+// The names are split at compile time from C++14; in C++11 they are split on first use.
+// Looking up a name is a lookup in a static_map of the N names.
+//
+// enum_set<E> is a set of enumerators, as a bitset of N bits, and enum_map<E, V> is a map
+// from every enumerator to a V, as an array of N values. Each stands in for std::set<E> and
+// std::map<E, V>, with a lookup that is a shift or an index rather than a tree walk. Both
+// are constexpr where C++14 allows, and neither allocates.
+
+// The expansion ends in a static_assert, so that the macro is followed by a semicolon.
+#define ESTD_ENUM(E, U, ...)                                                  \
+  enum class E : U { __VA_ARGS__ };                                           \
+  ESTD_ENUM_NAMES(E, __VA_ARGS__)
+
+#define ESTD_ENUM_NAMES(E, ...)                                               \
+  constexpr const char (&estd_enumerators(E))[sizeof(#__VA_ARGS__)]           \
+  {                                                                           \
+    return #__VA_ARGS__;                                                      \
+  }                                                                           \
+  static_assert(::Estd::impl::count_char(#__VA_ARGS__, '=') == 0,             \
+                "ESTD_ENUM: the enumerators must not have initializers")
+
+namespace Estd {
+
+namespace impl {
+
+// The number of c in s[b, e). The range is halved at each step, so the recursion is only
+// log(e - b) deep, and a long list of enumerators doesn't reach the compiler's limit.
+constexpr std::size_t count_char(const char* s, std::size_t b, std::size_t e, char c)
+{
+  return e - b == 0 ? 0
+       : e - b == 1 ? std::size_t(s[b] == c)
+       : count_char(s, b, b + (e - b) / 2, c) + count_char(s, b + (e - b) / 2, e, c);
+}
+
+template<std::size_t L>
+  constexpr std::size_t count_char(const char (&s)[L], char c)
+  {
+    return count_char(s, 0, L - 1, c);
+  }
+
+// Is there an estd_enumerators(E), found by argument-dependent lookup?
+template<typename E, bool = Enum<E>()>
+  struct has_enumerators {
+  private:
+    template<typename X>
+      static auto check(X x) -> decltype(estd_enumerators(x));
+
+    static substitution_failure check(...);
+
+    using type = decltype(check(std::declval<E>()));
+
+  public:
+    static constexpr bool value = Substitution_succeeded<type>();
+  };
+
+template<typename E>
+  struct has_enumerators<E, false> {
+    static constexpr bool value = false;
+  };
+
+}	// namespace impl
+
+// An enumeration declared with ESTD_ENUM, or named by ESTD_ENUM_NAMES.
+template<typename E>
+  constexpr bool Reflected_enum()
+  {
+    return impl::has_enumerators<E>::value;
+  }
+
+// The list of names is separated by commas.
+template<typename E>
+  constexpr std::size_t enum_count()
+  {
+    static_assert(Reflected_enum<E>(), "enum_count: E is not a reflected enumeration; see ESTD_ENUM");
+    return impl::count_char(estd_enumerators(E()), ',') + 1;
+  }
+
+template<typename E>
+  constexpr std::size_t enum_index(E e)
+  {
+    return static_cast<std::size_t>(static_cast<Underlying_type<E>>(e));
+  }
+
+namespace impl {
+
+template<typename E>
+  constexpr E enumerator(std::size_t i)
+  {
+    return static_cast<E>(static_cast<Underlying_type<E>>(i));
+  }
+
+// The names of the enumerators of E, split out of the list made by the preprocessor. The
+// preprocessor reduces the white space between the names to single spaces.
+template<typename E>
+  struct enum_names {
+    string_ref name[enum_count<E>()];
+
+    ESTD_CXX14_CONSTEXPR enum_names() : name()
+    {
+      const char* s = estd_enumerators(E());
+      for (std::size_t i = 0; i != enum_count<E>(); ++i) {
+        while (*s == ' ')
+          ++s;
+        const char* first = s;
+        while (*s != ',' && *s != ' ' && *s != '\0')
+          ++s;
+        name[i] = string_ref(first, std::size_t(s - first));
+        while (*s != ',' && *s != '\0')
+          ++s;
+        if (*s == ',')
+          ++s;
+      }
+    }
+  };
+
+template<typename E>
+  using Enum_name_map = static_map<string_ref, E, enum_count<E>()>;
+
+// The map from the names to the enumerators. It iterates in the order of the enumerators,
+// so it also maps the enumerators to their names.
+template<typename E, std::size_t... I>
+  ESTD_CXX14_CONSTEXPR Enum_name_map<E> make_enum_name_map(const enum_names<E>& names, index_sequence<I...>)
+  {
+    return Enum_name_map<E>({{names.name[I], enumerator<E>(I)}...});
+  }
+
+template<typename E, std::size_t... I>
+  ESTD_CXX14_CONSTEXPR Enum_name_map<E> make_enum_name_map(index_sequence<I...>)
+  {
+    return make_enum_name_map<E>(enum_names<E>(), index_sequence<I...>{});
+  }
+
+#if defined(ESTD_HAS_CXX14_CONSTEXPR)
+template<typename E>
+  struct enum_reflection {
+    static constexpr Enum_name_map<E> map = make_enum_name_map<E>(Estd::make_index_sequence<enum_count<E>()>{});
+  };
+
+template<typename E>
+  constexpr Enum_name_map<E> enum_reflection<E>::map;
+
+template<typename E>
+  constexpr const Enum_name_map<E>& enum_name_map()
+  {
+    return enum_reflection<E>::map;
+  }
+#else
+template<typename E>
+  const Enum_name_map<E>& enum_name_map()
+  {
+    static const Enum_name_map<E> map = make_enum_name_map<E>(Estd::make_index_sequence<enum_count<E>()>{});
+    return map;
+  }
+#endif
+
+}	// namespace impl
+
+template<typename E>
+  ESTD_CXX14_CONSTEXPR string_ref enum_name(E e)
+  {
+    return enum_index(e) < enum_count<E>() ? impl::enum_name_map<E>().begin()[enum_index(e)].first : string_ref();
+  }
+
+// Returns false, and leaves e alone, when s is not the name of an enumerator.
+template<typename E>
+  ESTD_CXX14_CONSTEXPR bool enum_value(string_ref s, E& e)
+  {
+    auto p = impl::enum_name_map<E>().find(s);
+    if (p == impl::enum_name_map<E>().end())
+      return false;
+    e = p->second;
+    return true;
+  }
+
+template<typename E>
+  ESTD_CXX14_CONSTEXPR E enum_value(string_ref s)
+  {
+    auto p = impl::enum_name_map<E>().find(s);
+    if (p == impl::enum_name_map<E>().end())
+      throw std::invalid_argument("enum_value: no enumerator has the name");
+    return p->second;
+  }
+
+// The niche of a reflected enumeration is the value after its last enumerator, if the
+// underlying type has it.
+template<typename E>
+  struct niche_traits<E, Enable_if<Reflected_enum<E>()>> {
+    static constexpr bool available = enum_count<E>() - 1 < std::size_t(std::numeric_limits<Underlying_type<E>>::max());
+
+    static constexpr E empty_value() { return impl::enumerator<E>(enum_count<E>()); }
+    static constexpr bool is_empty(E e) { return enum_index(e) == enum_count<E>(); }
+  };
+
+namespace impl {
+
+constexpr std::size_t enum_words(std::size_t n)
+{
+  return (n + 63) / 64;
+}
+
+// The first set bit of w[0, enum_words(n)) at or after bit i, or n.
+inline std::size_t next_enum_bit(const std::uint64_t* w, std::size_t i, std::size_t n)
+{
+  if (i >= n)
+    return n;
+  std::size_t k = i / 64;
+  std::uint64_t x = w[k] & (~std::uint64_t(0) << (i % 64));
+  while (x == 0) {
+    if (++k == enum_words(n))
+      return n;
+    x = w[k];
+  }
+  return k * 64 + countr_zero(x);
+}
+
+// Visits the enumerators of a set in order.
+template<typename E>
+  class enum_set_iterator
+    : public iterator_facade<enum_set_iterator<E>, E, E, std::forward_iterator_tag>
+  {
+    using facade = iterator_facade<enum_set_iterator<E>, E, E, std::forward_iterator_tag>;
+    friend facade;
+
+  public:
+    enum_set_iterator() : w(nullptr), i(0) { }
+
+    // The first enumerator at or after bit i.
+    enum_set_iterator(const std::uint64_t* w, std::size_t i)
+      : w(w), i(next_enum_bit(w, i, enum_count<E>()))
+    { }
+
+  private:
+    E dereference() const { return enumerator<E>(i); }
+    bool equal(const enum_set_iterator& x) const { return i == x.i; }
+    void increment() { i = next_enum_bit(w, i + 1, enum_count<E>()); }
+
+    const std::uint64_t* w;
+    std::size_t i;
+  };
+
+}	// namespace impl
+
+// A set of the enumerators of E. Enumerator e is bit enum_index(e) % 64 of word
+// enum_index(e) / 64, and the bits past the last enumerator are always zero. The arguments
+// of the members must be enumerators of E.
+template<typename E>
+  class enum_set {
+    static_assert(Reflected_enum<E>(), "enum_set: E is not a reflected enumeration; see ESTD_ENUM");
+
+    static constexpr std::size_t words = impl::enum_words(enum_count<E>());
+
+  public:
+    using key_type = E;
+    using value_type = E;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = E;
+    using const_reference = E;
+    using iterator = impl::enum_set_iterator<E>;
+    using const_iterator = impl::enum_set_iterator<E>;
+
+    constexpr enum_set() : w() { }
+
+    ESTD_CXX14_CONSTEXPR enum_set(std::initializer_list<E> list) : w()
+    {
+      for (E e : list)
+        insert(e);
+    }
+
+    // Every enumerator of E.
+    static ESTD_CXX14_CONSTEXPR enum_set all() { return ~enum_set(); }
+
+    static constexpr size_type max_size() { return enum_count<E>(); }
+
+    size_type size() const
+    {
+      size_type n = 0;
+      for (std::size_t k = 0; k != words; ++k)
+        n += impl::popcount(w[k]);
+      return n;
+    }
+
+    ESTD_CXX14_CONSTEXPR bool empty() const
+    {
+      for (std::size_t k = 0; k != words; ++k)
+        if (w[k])
+          return false;
+      return true;
+    }
+
+    constexpr bool contains(E e) const { return (w[enum_index(e) / 64] >> (enum_index(e) % 64)) & 1; }
+
+    constexpr size_type count(E e) const { return contains(e); }
+
+    // Returns true if e was not in the set.
+    ESTD_CXX14_CONSTEXPR bool insert(E e)
+    {
+      bool absent = !contains(e);
+      w[enum_index(e) / 64] |= bit(e);
+      return absent;
+    }
+
+    // Returns the number of elements erased, 0 or 1.
+    ESTD_CXX14_CONSTEXPR size_type erase(E e)
+    {
+      size_type present = count(e);
+      w[enum_index(e) / 64] &= ~bit(e);
+      return present;
+    }
+
+    ESTD_CXX14_CONSTEXPR void clear()
+    {
+      for (std::size_t k = 0; k != words; ++k)
+        w[k] = 0;
+    }
+
+    iterator begin() const { return iterator(w, 0); }
+    iterator end() const { return iterator(w, enum_count<E>()); }
+
+    // Union, intersection, symmetric difference, difference and complement.
+
+    ESTD_CXX14_CONSTEXPR enum_set& operator|=(const enum_set& x)
+    {
+      for (std::size_t k = 0; k != words; ++k)
+        w[k] |= x.w[k];
+      return *this;
+    }
+
+    ESTD_CXX14_CONSTEXPR enum_set& operator&=(const enum_set& x)
+    {
+      for (std::size_t k = 0; k != words; ++k)
+        w[k] &= x.w[k];
+      return *this;
+    }
+
+    ESTD_CXX14_CONSTEXPR enum_set& operator^=(const enum_set& x)
+    {
+      for (std::size_t k = 0; k != words; ++k)
+        w[k] ^= x.w[k];
+      return *this;
+    }
+
+    ESTD_CXX14_CONSTEXPR enum_set& operator-=(const enum_set& x)
+    {
+      for (std::size_t k = 0; k != words; ++k)
+        w[k] &= ~x.w[k];
+      return *this;
+    }
+
+    friend ESTD_CXX14_CONSTEXPR enum_set operator|(enum_set a, const enum_set& b) { return a |= b; }
+    friend ESTD_CXX14_CONSTEXPR enum_set operator&(enum_set a, const enum_set& b) { return a &= b; }
+    friend ESTD_CXX14_CONSTEXPR enum_set operator^(enum_set a, const enum_set& b) { return a ^= b; }
+    friend ESTD_CXX14_CONSTEXPR enum_set operator-(enum_set a, const enum_set& b) { return a -= b; }
+
+    friend ESTD_CXX14_CONSTEXPR enum_set operator~(enum_set a)
+    {
+      for (std::size_t k = 0; k != words; ++k)
+        a.w[k] = ~a.w[k];
+      if (enum_count<E>() % 64 != 0)
+        a.w[words - 1] &= (std::uint64_t(1) << (enum_count<E>() % 64)) - 1;
+      return a;
+    }
+
+    friend ESTD_CXX14_CONSTEXPR bool operator==(const enum_set& a, const enum_set& b)
+    {
+      for (std::size_t k = 0; k != words; ++k)
+        if (a.w[k] != b.w[k])
+          return false;
+      return true;
+    }
+
+    friend ESTD_CXX14_CONSTEXPR bool operator!=(const enum_set& a, const enum_set& b) { return !(a == b); }
+
+  private:
+    static constexpr std::uint64_t bit(E e) { return std::uint64_t(1) << (enum_index(e) % 64); }
+
+    std::uint64_t w[words];
+  };
+
+// A V for each enumerator of E, in the order of the enumerators. The keys of the map are
+// all the enumerators, always; the values start value-initialized. The arguments of the
+// members must be enumerators of E, except for at, which checks.
+template<typename E, typename V>
+  class enum_map {
+    static_assert(Reflected_enum<E>(), "enum_map: E is not a reflected enumeration; see ESTD_ENUM");
+    static_assert(Default_constructible<V>(), "enum_map: the mapped type must be Default_constructible");
+
+  public:
+    using key_type = E;
+    using mapped_type = V;
+    using value_type = V;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = V&;
+    using const_reference = const V&;
+    using iterator = V*;
+    using const_iterator = const V*;
+
+    constexpr enum_map() : v() { }
+
+    // The values of the listed enumerators; the others are value-initialized.
+    ESTD_CXX14_CONSTEXPR enum_map(std::initializer_list<std::pair<E, V>> list) : v()
+    {
+      for (const std::pair<E, V>& x : list)
+        v[enum_index(x.first)] = x.second;
+    }
+
+    static constexpr size_type size() { return enum_count<E>(); }
+    static constexpr bool empty() { return false; }
+
+    ESTD_CXX14_CONSTEXPR V& operator[](E e) { return v[enum_index(e)]; }
+    constexpr const V& operator[](E e) const { return v[enum_index(e)]; }
+
+    ESTD_CXX14_CONSTEXPR V& at(E e)
+    {
+      if (enum_index(e) >= size())
+        throw std::out_of_range("enum_map: not an enumerator");
+      return v[enum_index(e)];
+    }
+
+    ESTD_CXX14_CONSTEXPR const V& at(E e) const
+    {
+      if (enum_index(e) >= size())
+        throw std::out_of_range("enum_map: not an enumerator");
+      return v[enum_index(e)];
+    }
+
+    // The enumerator whose value is at p.
+    constexpr E key(const_iterator p) const { return impl::enumerator<E>(std::size_t(p - v)); }
+
+    ESTD_CXX14_CONSTEXPR void fill(const V& x)
+    {
+      for (V& y : v)
+        y = x;
+    }
+
+    ESTD_CXX14_CONSTEXPR V* data() { return v; }
+    constexpr const V* data() const { return v; }
+
+    ESTD_CXX14_CONSTEXPR iterator begin() { return v; }
+    ESTD_CXX14_CONSTEXPR iterator end() { return v + size(); }
+    constexpr const_iterator begin() const { return v; }
+    constexpr const_iterator end() const { return v + size(); }
+
+    friend ESTD_CXX14_CONSTEXPR bool operator==(const enum_map& a, const enum_map& b)
+    {
+      for (std::size_t i = 0; i != size(); ++i)
+        if (!(a.v[i] == b.v[i]))
+          return false;
+      return true;
+    }
+
+    friend ESTD_CXX14_CONSTEXPR bool operator!=(const enum_map& a, const enum_map& b) { return !(a == b); }
+
+  private:
+    V v[enum_count<E>()];
+  };
+
+}	// namespace Estd
+
+#endif	// ENUM_H
@@ -0,0 +1,471 @@
+#ifndef EXPECTED_H
+#define EXPECTED_H
+
+#include "constraints.h"
+#include "optional.h"
+#include "platform.h"
+#include <exception>
+#include <new>
+#include <utility>
+
+// expected<T, E> is a T, or an error E that says why there is no T, after C++23's
+// std::expected. A function returns make_unexpected(e) for the error:
+//
+//   expected<int, errc> parse_port(string_ref s);
+//
+//   auto port = parse_port(s);
+//   if (!port)
+//     return make_unexpected(port.error());
+//
+// expected<T, E> is a union of T and E with a flag, and is trivially copyable when T and
+// E are, and trivially destructible when they are. A niche can't tell the bytes of a T
+// from those of an E in the same place, so it doesn't shrink this layout. expected<void, E>,
+// for an operation that succeeds or fails without a result, is an optional E, so it has
+// the niche of E: expected<void, E> is the size of E when E has a niche (see niche.h).
+//
+// E must be nothrow move constructible, so that assigning a value over an error, or an
+// error over a value, leaves the object holding one of them even when a copy throws.
+
+namespace Estd {
+
+template<typename E>
+  class unexpected {
+    static_assert(Object<E>() && !Array<E>() && !Const<E>() && !Volatile<E>(),
+                  "unexpected: E must be a cv-unqualified object type and not an array");
+
+  public:
+    constexpr explicit unexpected(const E& e) : e(e) { }
+    constexpr explicit unexpected(E&& e) : e(static_cast<E&&>(e)) { }
+
+    ESTD_CXX14_CONSTEXPR E& error() { return e; }
+    constexpr const E& error() const { return e; }
+
+    friend constexpr bool operator==(const unexpected& a, const unexpected& b) { return a.e == b.e; }
+    friend constexpr bool operator!=(const unexpected& a, const unexpected& b) { return !(a.e == b.e); }
+
+  private:
+    E e;
+  };
+
+template<typename E>
+  constexpr unexpected<Decay<E>> make_unexpected(E&& e)
+  {
+    return unexpected<Decay<E>>(std::forward<E>(e));
+  }
+
+namespace impl {
+
+template<typename T>
+  struct is_unexpected : boolean_constant<false> { };
+
+template<typename E>
+  struct is_unexpected<unexpected<E>> : boolean_constant<true> { };
+
+}	// namespace impl
+
+// Selects the constructor of expected that makes an error in place.
+struct unexpect_t {
+  constexpr explicit unexpect_t() = default;
+};
+
+constexpr unexpect_t unexpect{};
+
+// Thrown by value() when there is an error instead; it carries a copy of the error.
+template<typename E>
+  class bad_expected_access : public std::exception {
+  public:
+    explicit bad_expected_access(E e) : e(std::move(e)) { }
+
+    const char* what() const noexcept override { return "bad_expected_access"; }
+
+    E& error() { return e; }
+    const E& error() const { return e; }
+
+  private:
+    E e;
+  };
+
+namespace impl {
+
+// Selects the constructor of expected_storage that copies or moves another.
+struct expected_copy_t { };
+
+// The storage of expected<T, E>: a T or an E, and which it is. construct_value and
+// construct_error are for a moment when the union holds neither.
+template<typename T, typename E,
+         bool = Trivially_destructible<T>() && Trivially_destructible<E>()>
+  struct expected_storage {
+    template<typename... Args>
+      constexpr explicit expected_storage(in_place_t, Args&&... args)
+        : x(std::forward<Args>(args)...), ok(true)
+      { }
+
+    template<typename... Args>
+      constexpr explicit expected_storage(unexpect_t, Args&&... args)
+        : e(std::forward<Args>(args)...), ok(false)
+      { }
+
+    // The T or E of o, copied or moved as S is an lvalue or an rvalue.
+    template<typename S>
+      expected_storage(expected_copy_t, S&& o)
+        : none(), ok(o.ok)
+      {
+        if (ok)
+          ::new (static_cast<void*>(&x)) T(std::forward<S>(o).x);
+        else
+          ::new (static_cast<void*>(&e)) E(std::forward<S>(o).e);
+      }
+
+    template<typename... Args>
+      void construct_value(Args&&... args)
+      {
+        ::new (static_cast<void*>(&x)) T(std::forward<Args>(args)...);
+        ok = true;
+      }
+
+    template<typename... Args>
+      void construct_error(Args&&... args)
+      {
+        ::new (static_cast<void*>(&e)) E(std::forward<Args>(args)...);
+        ok = false;
+      }
+
+    union {
+      char none;
+      T x;
+      E e;
+    };
+    bool ok;
+  };
+
+// As above, with a destructor for T and E.
+template<typename T, typename E>
+  struct expected_storage<T, E, false> {
+    template<typename... Args>
+      constexpr explicit expected_storage(in_place_t, Args&&... args)
+        : x(std::forward<Args>(args)...), ok(true)
+      { }
+
+    template<typename... Args>
+      constexpr explicit expected_storage(unexpect_t, Args&&... args)
+        : e(std::forward<Args>(args)...), ok(false)
+      { }
+
+    // The T or E of o, copied or moved as S is an lvalue or an rvalue. If that throws,
+    // the destructor doesn't run, so it never sees a union that holds neither.
+    template<typename S>
+      expected_storage(expected_copy_t, S&& o)
+        : none(), ok(o.ok)
+      {
+        if (ok)
+          ::new (static_cast<void*>(&x)) T(std::forward<S>(o).x);
+        else
+          ::new (static_cast<void*>(&e)) E(std::forward<S>(o).e);
+      }
+
+    ~expected_storage()
+    {
+      if (ok)
+        x.~T();
+      else
+        e.~E();
+    }
+
+    template<typename... Args>
+      void construct_value(Args&&... args)
+      {
+        ::new (static_cast<void*>(&x)) T(std::forward<Args>(args)...);
+        ok = true;
+      }
+
+    template<typename... Args>
+      void construct_error(Args&&... args)
+      {
+        ::new (static_cast<void*>(&e)) E(std::forward<Args>(args)...);
+        ok = false;
+      }
+
+    union {
+      char none;
+      T x;
+      E e;
+    };
+    bool ok;
+  };
+
+// Assignment of a value or an error. Replacing an error with a value moves the error aside
+// first, and puts it back if making the value throws; replacing a value with an error
+// makes the error first. Either way s holds a T or an E when an exception leaves.
+
+template<typename T, typename E, typename U>
+  void expected_assign_value(expected_storage<T, E>& s, U&& x)
+  {
+    if (s.ok) {
+      s.x = std::forward<U>(x);
+      return;
+    }
+    E saved(std::move(s.e));
+    s.e.~E();
+    try {
+      s.construct_value(std::forward<U>(x));
+    } catch (...) {
+      s.construct_error(std::move(saved));
+      throw;
+    }
+  }
+
+template<typename T, typename E, typename U>
+  void expected_assign_error(expected_storage<T, E>& s, U&& e)
+  {
+    if (!s.ok) {
+      s.e = std::forward<U>(e);
+      return;
+    }
+    E made(std::forward<U>(e));
+    s.x.~T();
+    s.construct_error(std::move(made));
+  }
+
+// The copy and move operations, spelled out unless T and E are trivially copyable.
+template<typename T, typename E, bool = Trivially_copyable<T>() && Trivially_copyable<E>()>
+  struct expected_base : expected_storage<T, E> {
+    using expected_storage<T, E>::expected_storage;
+  };
+
+template<typename T, typename E>
+  struct expected_base<T, E, false> : expected_storage<T, E> {
+    using expected_storage<T, E>::expected_storage;
+
+    expected_base(const expected_base& o)
+      : expected_storage<T, E>(expected_copy_t{}, o)
+    { }
+
+    expected_base(expected_base&& o) noexcept(Nothrow_move_constructible<T>())
+      : expected_storage<T, E>(expected_copy_t{}, std::move(o))
+    { }
+
+    expected_base& operator=(const expected_base& o)
+    {
+      if (o.ok)
+        expected_assign_value(*this, o.x);
+      else
+        expected_assign_error(*this, o.e);
+      return *this;
+    }
+
+    expected_base& operator=(expected_base&& o)
+      noexcept(Nothrow_move_constructible<T>() && Nothrow_move_assignable<T>() && Nothrow_move_assignable<E>())
+    {
+      if (o.ok)
+        expected_assign_value(*this, std::move(o.x));
+      else
+        expected_assign_error(*this, std::move(o.e));
+      return *this;
+    }
+  };
+
+}	// namespace impl
+
+template<typename T, typename E>
+  class expected : private impl::expected_base<T, E> {
+    static_assert(Object<T>() && !Array<T>(), "expected: T must be an object type and not an array");
+    static_assert(Nothrow_move_constructible<E>(), "expected: E must be nothrow move constructible");
+
+    using base = impl::expected_base<T, E>;
+
+  public:
+    using value_type = T;
+    using error_type = E;
+    using unexpected_type = unexpected<E>;
+
+    constexpr expected() : base(in_place) { }
+
+    // From a T, or what converts to one.
+    template<typename U = T,
+             typename = Enable_if<Convertible<U, T>()
+                               && !Same<Decay<U>, expected>()
+                               && !Same<Decay<U>, in_place_t>()
+                               && !Same<Decay<U>, unexpect_t>()
+                               && !impl::is_unexpected<Decay<U>>::value>>
+      constexpr expected(U&& x) : base(in_place, std::forward<U>(x)) { }
+
+    template<typename G>
+      constexpr expected(const unexpected<G>& u) : base(unexpect, u.error()) { }
+
+    template<typename G>
+      constexpr expected(unexpected<G>&& u) : base(unexpect, static_cast<G&&>(u.error())) { }
+
+    template<typename... Args>
+      constexpr explicit expected(in_place_t, Args&&... args)
+        : base(in_place, std::forward<Args>(args)...)
+      { }
+
+    template<typename... Args>
+      constexpr explicit expected(unexpect_t, Args&&... args)
+        : base(unexpect, std::forward<Args>(args)...)
+      { }
+
+    expected& operator=(const T& x)
+    {
+      assign_value(x);
+      return *this;
+    }
+
+    expected& operator=(T&& x)
+    {
+      assign_value(std::move(x));
+      return *this;
+    }
+
+    template<typename G>
+      expected& operator=(const unexpected<G>& u)
+      {
+        assign_error(u.error());
+        return *this;
+      }
+
+    template<typename G>
+      expected& operator=(unexpected<G>&& u)
+      {
+        assign_error(std::move(u.error()));
+        return *this;
+      }
+
+    template<typename... Args>
+      T& emplace(Args&&... args)
+      {
+        assign_value(T(std::forward<Args>(args)...));
+        return this->x;
+      }
+
+    constexpr bool has_value() const noexcept { return this->ok; }
+    constexpr explicit operator bool() const noexcept { return this->ok; }
+
+    // The value. There must be one.
+    ESTD_CXX14_CONSTEXPR T& operator*() { return this->x; }
+    constexpr const T& operator*() const { return this->x; }
+
+    ESTD_CXX14_CONSTEXPR T* operator->() { return &this->x; }
+    constexpr const T* operator->() const { return &this->x; }
+
+    // The value, or bad_expected_access with a copy of the error.
+    ESTD_CXX14_CONSTEXPR T& value()
+    {
+      if (!has_value())
+        throw bad_expected_access<E>(this->e);
+      return this->x;
+    }
+
+    ESTD_CXX14_CONSTEXPR const T& value() const
+    {
+      if (!has_value())
+        throw bad_expected_access<E>(this->e);
+      return this->x;
+    }
+
+    // The error. There must be one.
+    ESTD_CXX14_CONSTEXPR E& error() { return this->e; }
+    constexpr const E& error() const { return this->e; }
+
+    template<typename U>
+      constexpr T value_or(U&& x) const
+      {
+        return has_value() ? this->x : static_cast<T>(std::forward<U>(x));
+      }
+
+    friend constexpr bool operator==(const expected& a, const expected& b)
+    {
+      return a.has_value() == b.has_value() && (a.has_value() ? *a == *b : a.error() == b.error());
+    }
+
+    friend constexpr bool operator!=(const expected& a, const expected& b) { return !(a == b); }
+
+    friend constexpr bool operator==(const expected& a, const T& x) { return a.has_value() && *a == x; }
+    friend constexpr bool operator==(const T& x, const expected& a) { return a.has_value() && *a == x; }
+    friend constexpr bool operator!=(const expected& a, const T& x) { return !(a == x); }
+    friend constexpr bool operator!=(const T& x, const expected& a) { return !(a == x); }
+
+    friend constexpr bool operator==(const expected& a, const unexpected<E>& u) { return !a.has_value() && a.error() == u.error(); }
+    friend constexpr bool operator==(const unexpected<E>& u, const expected& a) { return a == u; }
+    friend constexpr bool operator!=(const expected& a, const unexpected<E>& u) { return !(a == u); }
+    friend constexpr bool operator!=(const unexpected<E>& u, const expected& a) { return !(a == u); }
+
+  private:
+    template<typename U>
+      void assign_value(U&& x) { impl::expected_assign_value<T, E>(*this, std::forward<U>(x)); }
+
+    template<typename U>
+      void assign_error(U&& e) { impl::expected_assign_error<T, E>(*this, std::forward<U>(e)); }
+  };
+
+// Success, or an error: an optional<E> that is empty on success.
+template<typename E>
+  class expected<void, E> {
+  public:
+    using value_type = void;
+    using error_type = E;
+    using unexpected_type = unexpected<E>;
+
+    constexpr expected() noexcept { }
+
+    template<typename G>
+      constexpr expected(const unexpected<G>& u) : err(in_place, u.error()) { }
+
+    template<typename G>
+      constexpr expected(unexpected<G>&& u) : err(in_place, static_cast<G&&>(u.error())) { }
+
+    constexpr explicit expected(in_place_t) noexcept { }
+
+    template<typename... Args>
+      constexpr explicit expected(unexpect_t, Args&&... args)
+        : err(in_place, std::forward<Args>(args)...)
+      { }
+
+    template<typename G>
+      ESTD_CXX14_CONSTEXPR expected& operator=(const unexpected<G>& u)
+      {
+        err = u.error();
+        return *this;
+      }
+
+    template<typename G>
+      ESTD_CXX14_CONSTEXPR expected& operator=(unexpected<G>&& u)
+      {
+        err = std::move(u.error());
+        return *this;
+      }
+
+    // Clears the error.
+    ESTD_CXX14_CONSTEXPR void emplace() noexcept { err.reset(); }
+
+    constexpr bool has_value() const noexcept { return !err.has_value(); }
+    constexpr explicit operator bool() const noexcept { return !err.has_value(); }
+
+    ESTD_CXX14_CONSTEXPR void operator*() const noexcept { }
+
+    // Nothing, or bad_expected_access with a copy of the error.
+    ESTD_CXX14_CONSTEXPR void value() const
+    {
+      if (err.has_value())
+        throw bad_expected_access<E>(*err);
+    }
+
+    // The error. There must be one.
+    ESTD_CXX14_CONSTEXPR E& error() { return *err; }
+    constexpr const E& error() const { return *err; }
+
+    friend constexpr bool operator==(const expected& a, const expected& b) { return a.err == b.err; }
+    friend constexpr bool operator!=(const expected& a, const expected& b) { return !(a.err == b.err); }
+
+    friend constexpr bool operator==(const expected& a, const unexpected<E>& u) { return a.err == u.error(); }
+    friend constexpr bool operator==(const unexpected<E>& u, const expected& a) { return a.err == u.error(); }
+    friend constexpr bool operator!=(const expected& a, const unexpected<E>& u) { return !(a == u); }
+    friend constexpr bool operator!=(const unexpected<E>& u, const expected& a) { return !(a == u); }
+
+  private:
+    optional<E> err;
+  };
+
+}	// namespace Estd
+
+#endif	// EXPECTED_H
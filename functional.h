@@ -0,0 +1,298 @@
+#ifndef FUNCTIONAL_H
+#define FUNCTIONAL_H
+
+#include "traits.h"
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Type-erased callables that never allocate - compare std::function, pg. 969.
+//
+// function_ref<R(Args...)> refers to a callable owned by someone else. It is two pointers
+// wide and is meant for parameters: a function taking function_ref<void(int)> accepts any
+// callable without being a template and without copying it.
+//
+// inplace_function<R(Args...), Capacity> owns a copy of its callable, like std::function,
+// but keeps it in a buffer of Capacity bytes inside the object. A callable that doesn't fit
+// is rejected at compile time instead of being put on the heap. So is one whose move
+// constructor can throw: moving an inplace_function moves the callable, and that must not
+// fail for the moves to be noexcept, which is what lets containers move rather than copy.
+//
+// Both accept whatever Has_call accepts: function pointers, function objects, and pointers
+// to member functions and member data with an object, pointer or smart pointer as the first
+// argument. The call itself goes through impl::invoke, as Result_of does.
+
+namespace Estd {
+
+namespace impl {
+
+// Can an F be called with Args..., yielding something convertible to R?
+// Any result will do if R is void.
+template<typename F, typename R, typename... Args>
+  constexpr bool Callable_as()
+  {
+    return Has_call<F, Args...>()
+        && (Void<R>() || Convertible<Result_of<F(Args...)>, R>());
+  }
+
+// The operations on the callable held by an inplace_function.
+template<typename R, typename... Args>
+  struct inplace_vtable {
+    R (*call)(void*, Args...);
+    void (*copy)(void*, const void*);	// Copy construct into the first buffer.
+    void (*relocate)(void*, void*);	// Move construct into the first buffer, destroy the second.
+    void (*destroy)(void*);
+  };
+
+// The table of an empty inplace_function. Having one means the copy, move and destroy
+// paths never have to test for emptiness.
+template<typename R, typename... Args>
+  struct empty_callable {
+    static R call(void*, Args...) { throw std::bad_function_call(); }
+    static void copy(void*, const void*) { }
+    static void relocate(void*, void*) { }
+    static void destroy(void*) { }
+
+    static const inplace_vtable<R, Args...> table;
+  };
+
+template<typename R, typename... Args>
+  const inplace_vtable<R, Args...> empty_callable<R, Args...>::table = {
+    &empty_callable::call, &empty_callable::copy, &empty_callable::relocate, &empty_callable::destroy
+  };
+
+// The table of an inplace_function holding an F.
+template<typename F, typename R, typename... Args>
+  struct stored_callable {
+    static R call(void* p, Args... args)
+    {
+      return static_cast<R>(invoke::fn(*static_cast<F*>(p), std::forward<Args>(args)...));
+    }
+
+    static void copy(void* to, const void* from)
+    {
+      ::new (to) F(*static_cast<const F*>(from));
+    }
+
+    static void relocate(void* to, void* from)
+    {
+      F* f = static_cast<F*>(from);
+      ::new (to) F(std::move(*f));
+      f->~F();
+    }
+
+    static void destroy(void* p)
+    {
+      static_cast<F*>(p)->~F();
+    }
+
+    static const inplace_vtable<R, Args...> table;
+  };
+
+template<typename F, typename R, typename... Args>
+  const inplace_vtable<R, Args...> stored_callable<F, R, Args...>::table = {
+    &stored_callable::call, &stored_callable::copy, &stored_callable::relocate, &stored_callable::destroy
+  };
+
+}	// namespace impl
+
+// function_ref
+
+template<typename Signature>
+  class function_ref;
+
+template<typename R, typename... Args>
+  class function_ref<R(Args...)> {
+    // A function pointer can't be stored in a void*, so we keep either kind of pointer.
+    union target {
+      void* object;
+      void (*function)();
+    };
+
+  public:
+    // Refer to f. For a function or function pointer, the pointer itself is kept;
+    // for anything else, f must outlive the function_ref. That includes pointers to members,
+    // so `function_ref<int(S&)> r = &S::get;` dangles; name the member pointer first.
+    template<typename F,
+             typename = Enable_if<!Same<Decay<F>, function_ref>()
+                               && impl::Callable_as<F&, R, Args...>()>>
+      function_ref(F&& f) noexcept
+      {
+        bind(f, boolean_constant<Pointer<Decay<F>>() && Function_type<Remove_pointer<Decay<F>>>()>{});
+      }
+
+    R operator()(Args... args) const
+    {
+      return thunk(t, std::forward<Args>(args)...);
+    }
+
+  private:
+    template<typename F>
+      void bind(F& f, boolean_constant<false>)
+      {
+        t.object = const_cast<void*>(static_cast<const void*>(std::addressof(f)));
+        thunk = &call_object<F>;
+      }
+
+    template<typename F>
+      void bind(F& f, boolean_constant<true>)
+      {
+        using P = Decay<F>;
+        t.function = reinterpret_cast<void (*)()>(static_cast<P>(f));
+        thunk = &call_function<P>;
+      }
+
+    template<typename F>
+      static R call_object(target t, Args... args)
+      {
+        return static_cast<R>(impl::invoke::fn(*static_cast<F*>(t.object), std::forward<Args>(args)...));
+      }
+
+    template<typename P>
+      static R call_function(target t, Args... args)
+      {
+        return static_cast<R>(impl::invoke::fn(reinterpret_cast<P>(t.function), std::forward<Args>(args)...));
+      }
+
+    target t;
+    R (*thunk)(target, Args...);
+  };
+
+// inplace_function
+
+template<typename Signature,
+         std::size_t Capacity = 4 * sizeof(void*),
+         std::size_t Align = alignof(std::max_align_t)>
+  class inplace_function;
+
+template<typename R, typename... Args, std::size_t Capacity, std::size_t Align>
+  class inplace_function<R(Args...), Capacity, Align> {
+    using vtable = impl::inplace_vtable<R, Args...>;
+
+  public:
+    static constexpr std::size_t capacity = Capacity;
+
+    inplace_function() noexcept
+      : ops(&impl::empty_callable<R, Args...>::table)
+    { }
+
+    inplace_function(std::nullptr_t) noexcept
+      : inplace_function()
+    { }
+
+    template<typename F,
+             typename = Enable_if<!Same<Decay<F>, inplace_function>()
+                               && impl::Callable_as<Decay<F>&, R, Args...>()>>
+      inplace_function(F&& f)
+      {
+        using C = Decay<F>;
+        static_assert(sizeof(C) <= Capacity, "inplace_function: the callable does not fit in Capacity bytes");
+        static_assert(Align % alignof(C) == 0, "inplace_function: the callable is over-aligned for the buffer");
+        static_assert(Copy_constructible<C>(), "inplace_function: the callable must be copy constructible");
+        static_assert(Nothrow_move_constructible<C>(), "inplace_function: the callable must be nothrow move constructible");
+
+        ::new (static_cast<void*>(&buffer)) C(std::forward<F>(f));
+        ops = &impl::stored_callable<C, R, Args...>::table;
+      }
+
+    inplace_function(const inplace_function& x)
+      : ops(x.ops)
+    {
+      ops->copy(&buffer, &x.buffer);
+    }
+
+    inplace_function(inplace_function&& x) noexcept
+      : ops(x.ops)
+    {
+      ops->relocate(&buffer, &x.buffer);
+      x.ops = &impl::empty_callable<R, Args...>::table;
+    }
+
+    ~inplace_function()
+    {
+      ops->destroy(&buffer);
+    }
+
+    inplace_function& operator=(const inplace_function& x)
+    {
+      if (this != &x) {
+        inplace_function tmp(x);
+        *this = std::move(tmp);
+      }
+      return *this;
+    }
+
+    inplace_function& operator=(inplace_function&& x) noexcept
+    {
+      if (this != &x) {
+        ops->destroy(&buffer);
+        ops = &impl::empty_callable<R, Args...>::table;
+        x.ops->relocate(&buffer, &x.buffer);
+        ops = x.ops;
+        x.ops = &impl::empty_callable<R, Args...>::table;
+      }
+      return *this;
+    }
+
+    inplace_function& operator=(std::nullptr_t) noexcept
+    {
+      ops->destroy(&buffer);
+      ops = &impl::empty_callable<R, Args...>::table;
+      return *this;
+    }
+
+    template<typename F,
+             typename = Enable_if<!Same<Decay<F>, inplace_function>()
+                               && impl::Callable_as<Decay<F>&, R, Args...>()>>
+      inplace_function& operator=(F&& f)
+      {
+        return *this = inplace_function(std::forward<F>(f));
+      }
+
+    void swap(inplace_function& x)
+    {
+      inplace_function tmp(std::move(x));
+      x = std::move(*this);
+      *this = std::move(tmp);
+    }
+
+    explicit operator bool() const noexcept
+    {
+      return ops != &impl::empty_callable<R, Args...>::table;
+    }
+
+    // Calling an empty inplace_function throws std::bad_function_call.
+    R operator()(Args... args) const
+    {
+      return ops->call(const_cast<void*>(static_cast<const void*>(&buffer)), std::forward<Args>(args)...);
+    }
+
+  private:
+    typename std::aligned_storage<Capacity, Align>::type buffer;
+    const vtable* ops;
+  };
+
+template<typename Signature, std::size_t Capacity, std::size_t Align>
+  void swap(inplace_function<Signature, Capacity, Align>& a, inplace_function<Signature, Capacity, Align>& b)
+  {
+    a.swap(b);
+  }
+
+template<typename Signature, std::size_t Capacity, std::size_t Align>
+  bool operator==(const inplace_function<Signature, Capacity, Align>& f, std::nullptr_t) noexcept
+  {
+    return !f;
+  }
+
+template<typename Signature, std::size_t Capacity, std::size_t Align>
+  bool operator!=(const inplace_function<Signature, Capacity, Align>& f, std::nullptr_t) noexcept
+  {
+    return static_cast<bool>(f);
+  }
+
+}	// namespace Estd
+
+#endif	// FUNCTIONAL_H
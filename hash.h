@@ -0,0 +1,159 @@
+#ifndef HASH_H
+#define HASH_H
+
+#include "constraints.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+
+// Hashing - compare std::hash, pg. 915.
+//
+// hash_bytes(p, n, seed) hashes n bytes with the rounds of XXH64: four independent lanes take
+// 32 bytes per step, so the multiplies of one lane overlap those of the others, and a final
+// avalanche spreads every input bit over the result.
+//
+// hash<T> can replace std::hash<T> in the unordered containers. For a Bitwise_comparable T it
+// hashes the bytes of the object, which agrees with == because equal values have equal bytes.
+// A record that opts in through bitwise_comparable_traits needs no hash of its own. For a
+// Contiguous_range of Bitwise_comparable elements, such as std::vector<int> or std::string,
+// it hashes all the elements' bytes at once instead of combining a hash per element.
+// Anything else is hashed with std::hash<T>.
+
+namespace Estd {
+
+namespace impl {
+
+constexpr std::uint64_t hash_p1 = 0x9e3779b185ebca87u;
+constexpr std::uint64_t hash_p2 = 0xc2b2ae3d27d4eb4fu;
+constexpr std::uint64_t hash_p3 = 0x165667b19e3779f9u;
+constexpr std::uint64_t hash_p4 = 0x85ebca77c2b2ae63u;
+constexpr std::uint64_t hash_p5 = 0x27d4eb2f165667c5u;
+
+inline std::uint64_t rotl(std::uint64_t x, unsigned r)
+{
+  return (x << r) | (x >> (64 - r));
+}
+
+// Unaligned loads. The compiler turns each into a single mov.
+
+inline std::uint64_t load64(const unsigned char* p)
+{
+  std::uint64_t x;
+  std::memcpy(&x, p, sizeof(x));
+  return x;
+}
+
+inline std::uint32_t load32(const unsigned char* p)
+{
+  std::uint32_t x;
+  std::memcpy(&x, p, sizeof(x));
+  return x;
+}
+
+inline std::uint64_t hash_round(std::uint64_t acc, std::uint64_t x)
+{
+  return rotl(acc + x * hash_p2, 31) * hash_p1;
+}
+
+inline std::uint64_t hash_merge(std::uint64_t h, std::uint64_t v)
+{
+  return (h ^ hash_round(0, v)) * hash_p1 + hash_p4;
+}
+
+}	// namespace impl
+
+inline std::uint64_t hash_bytes(const void* data, std::size_t n, std::uint64_t seed = 0)
+{
+  const unsigned char* p = static_cast<const unsigned char*>(data);
+  const unsigned char* const end = p + n;
+  std::uint64_t h;
+
+  if (n >= 32) {
+    std::uint64_t v1 = seed + impl::hash_p1 + impl::hash_p2;
+    std::uint64_t v2 = seed + impl::hash_p2;
+    std::uint64_t v3 = seed;
+    std::uint64_t v4 = seed - impl::hash_p1;
+    for (; end - p >= 32; p += 32) {
+      v1 = impl::hash_round(v1, impl::load64(p));
+      v2 = impl::hash_round(v2, impl::load64(p + 8));
+      v3 = impl::hash_round(v3, impl::load64(p + 16));
+      v4 = impl::hash_round(v4, impl::load64(p + 24));
+    }
+    h = impl::rotl(v1, 1) + impl::rotl(v2, 7) + impl::rotl(v3, 12) + impl::rotl(v4, 18);
+    h = impl::hash_merge(h, v1);
+    h = impl::hash_merge(h, v2);
+    h = impl::hash_merge(h, v3);
+    h = impl::hash_merge(h, v4);
+  } else {
+    h = seed + impl::hash_p5;
+  }
+  h += n;
+
+  for (; end - p >= 8; p += 8)
+    h = impl::rotl(h ^ impl::hash_round(0, impl::load64(p)), 27) * impl::hash_p1 + impl::hash_p4;
+  if (end - p >= 4) {
+    h = impl::rotl(h ^ (impl::load32(p) * impl::hash_p1), 23) * impl::hash_p2 + impl::hash_p3;
+    p += 4;
+  }
+  for (; p != end; ++p)
+    h = impl::rotl(h ^ (*p * impl::hash_p5), 11) * impl::hash_p1;
+
+  h ^= h >> 33;
+  h *= impl::hash_p2;
+  h ^= h >> 29;
+  h *= impl::hash_p3;
+  h ^= h >> 32;
+  return h;
+}
+
+namespace impl {
+
+enum hash_method {
+  hash_object_bytes,
+  hash_element_bytes,
+  hash_std
+};
+
+template<hash_method M>
+  using hash_method_constant = integral_constant<hash_method, M>;
+
+template<typename T>
+  constexpr hash_method hash_method_of()
+  {
+    return Bitwise_comparable<T>() ? hash_object_bytes
+         : Contiguous_range<const T&>() && Bitwise_comparable<Value_type<T>>() ? hash_element_bytes
+         : hash_std;
+  }
+
+template<typename T>
+  std::size_t hash_value(const T& x, hash_method_constant<hash_object_bytes>)
+  {
+    return static_cast<std::size_t>(hash_bytes(&x, sizeof(T)));
+  }
+
+template<typename T>
+  std::size_t hash_value(const T& x, hash_method_constant<hash_element_bytes>)
+  {
+    return static_cast<std::size_t>(hash_bytes(contiguous_data(x), contiguous_size(x) * sizeof(Value_type<T>)));
+  }
+
+template<typename T>
+  std::size_t hash_value(const T& x, hash_method_constant<hash_std>)
+  {
+    return std::hash<T>{}(x);
+  }
+
+}	// namespace impl
+
+template<typename T>
+  struct hash {
+    std::size_t operator()(const T& x) const
+    {
+      return impl::hash_value(x, impl::hash_method_constant<impl::hash_method_of<T>()>{});
+    }
+  };
+
+}	// namespace Estd
+
+#endif	// HASH_H
@@ -0,0 +1,124 @@
+#ifndef BIT_VECTOR_H
+#error This file cannot be included directly. Include bit_vector.h
+#endif	// BIT_VECTOR_H
+
+// Kernels over arrays of 64-bit words, for bit_vector and rank_select_index.
+//
+// Each kernel has a portable loop over words, which uses popcnt and tzcnt through platform.h.
+// When the target has AVX2 (-mavx2, or -march=haswell and later), the bulk of the array is
+// processed 256 bits at a time, and the scalar loop finishes the last few words. The choice
+// is made at compile time, like the rest of the library's hardware support.
+
+namespace impl {
+
+constexpr std::size_t word_bits = 64;
+
+inline std::size_t words_for(std::size_t bits)
+{
+  return (bits + word_bits - 1) / word_bits;
+}
+
+// The mask of the bits below position i of a word, for i < 64.
+inline std::uint64_t low_bits(std::size_t i)
+{
+  return (std::uint64_t(1) << i) - 1;
+}
+
+// The binary word operations. Each applies to a pair of words, and to a pair of AVX2 registers.
+
+struct and_words {
+  std::uint64_t operator()(std::uint64_t a, std::uint64_t b) const { return a & b; }
+#if defined(__AVX2__)
+  __m256i operator()(__m256i a, __m256i b) const { return _mm256_and_si256(a, b); }
+#endif
+};
+
+struct or_words {
+  std::uint64_t operator()(std::uint64_t a, std::uint64_t b) const { return a | b; }
+#if defined(__AVX2__)
+  __m256i operator()(__m256i a, __m256i b) const { return _mm256_or_si256(a, b); }
+#endif
+};
+
+struct xor_words {
+  std::uint64_t operator()(std::uint64_t a, std::uint64_t b) const { return a ^ b; }
+#if defined(__AVX2__)
+  __m256i operator()(__m256i a, __m256i b) const { return _mm256_xor_si256(a, b); }
+#endif
+};
+
+// d[i] = op(d[i], s[i]) for i in [0, n).
+template<typename Op>
+  void transform_words(std::uint64_t* d, const std::uint64_t* s, std::size_t n, Op op)
+  {
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    for (; i + 4 <= n; i += 4) {
+      __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d + i));
+      __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i), op(a, b));
+    }
+#endif
+    for (; i != n; ++i)
+      d[i] = op(d[i], s[i]);
+  }
+
+// The number of set bits in p[0, n).
+//
+// The AVX2 loop is Mula's: each nibble is looked up in a 16-entry table with vpshufb, and
+// the byte counts are summed into 64-bit lanes with vpsadbw. It is faster than one popcnt
+// per word once there are more than a few dozen words.
+inline std::uint64_t count_words(const std::uint64_t* p, std::size_t n)
+{
+  std::uint64_t c = 0;
+  std::size_t i = 0;
+#if defined(__AVX2__)
+  const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                         0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+  const __m256i nibble = _mm256_set1_epi8(0x0f);
+  __m256i sums = _mm256_setzero_si256();
+  for (; i + 4 <= n; i += 4) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+    __m256i lo = _mm256_shuffle_epi8(table, _mm256_and_si256(v, nibble));
+    __m256i hi = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+    sums = _mm256_add_epi64(sums, _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256()));
+  }
+  c = static_cast<std::uint64_t>(_mm256_extract_epi64(sums, 0))
+    + static_cast<std::uint64_t>(_mm256_extract_epi64(sums, 1))
+    + static_cast<std::uint64_t>(_mm256_extract_epi64(sums, 2))
+    + static_cast<std::uint64_t>(_mm256_extract_epi64(sums, 3));
+#endif
+  for (; i != n; ++i)
+    c += popcount(p[i]);
+  return c;
+}
+
+// The index of the first non-zero word in p[i, n), or n.
+inline std::size_t find_word(const std::uint64_t* p, std::size_t i, std::size_t n)
+{
+#if defined(__AVX2__)
+  for (; i + 4 <= n; i += 4) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+    if (!_mm256_testz_si256(v, v))
+      break;
+  }
+#endif
+  while (i != n && p[i] == 0)
+    ++i;
+  return i;
+}
+
+// The position of the set bit of x with k set bits below it. x must have more than k set bits.
+// With BMI2, pdep deposits a single bit at that position.
+inline unsigned select_in_word(std::uint64_t x, unsigned k)
+{
+#if defined(__BMI2__)
+  return countr_zero(_pdep_u64(std::uint64_t(1) << k, x));
+#else
+  for (; k != 0; --k)
+    x &= x - 1;
+  return countr_zero(x);
+#endif
+}
+
+}	// namespace impl
@@ -0,0 +1,100 @@
+#ifndef ALGORITHM_H
+#error This file cannot be included directly. Include algorithm.h
+#endif	// ALGORITHM_H
+
+// equal and mismatch over arrays of Bitwise_comparable values.
+//
+// Two such arrays are equal when their bytes are, so equal is one memcmp. The standard library
+// does this for the built-in integers and pointers only; here it also covers enumerations,
+// pairs, and the classes that opt in through bitwise_comparable_traits. mismatch compares
+// blocks of bytes with memcmp, and looks for the differing element only in the block that
+// differs.
+//
+// The iterators must be pointers. The range overloads also take this path for contiguous
+// ranges, such as std::vector, whose iterators are not pointers.
+
+namespace impl {
+
+// Can [first1, last1) and [first2, ...) be compared as bytes?
+template<typename I1, typename I2>
+  constexpr bool Bitwise_iterators()
+  {
+    return Pointer<I1>()
+        && Pointer<I2>()
+        && Same<Remove_cv<Value_type<I1>>, Remove_cv<Value_type<I2>>>()
+        && Bitwise_comparable<Value_type<I1>>();
+  }
+
+// The number of bytes mismatch compares with each memcmp.
+constexpr std::size_t mismatch_block = 256;
+
+// The offset of the first byte at which p and q differ, or n.
+inline std::size_t mismatch_bytes(const unsigned char* p, const unsigned char* q, std::size_t n)
+{
+  std::size_t i = 0;
+  while (i != n) {
+    std::size_t m = std::min(mismatch_block, n - i);
+    if (std::memcmp(p + i, q + i, m) != 0)
+      break;
+    i += m;
+  }
+  while (i != n && p[i] == q[i])
+    ++i;
+  return i;
+}
+
+template<typename T, typename U>
+  bool equal_bytes(T* first1, T* last1, U* first2)
+  {
+    std::size_t n = last1 - first1;
+    return n == 0 || std::memcmp(first1, first2, n * sizeof(T)) == 0;
+  }
+
+template<typename T, typename U>
+  std::pair<T*, U*> mismatch_bytes(T* first1, T* last1, U* first2)
+  {
+    std::size_t n = last1 - first1;
+    if (n == 0)
+      return {first1, first2};
+    std::size_t i = mismatch_bytes(reinterpret_cast<const unsigned char*>(first1),
+                                   reinterpret_cast<const unsigned char*>(first2),
+                                   n * sizeof(T)) / sizeof(T);
+    return {first1 + i, first2 + i};
+  }
+
+// Dispatch for iterator pairs of the same type.
+
+template<typename I1, typename I2>
+  bool equal_iterators(I1 first1, I1 last1, I2 first2, boolean_constant<true>)
+  {
+    return equal_bytes(first1, last1, first2);
+  }
+
+template<typename I1, typename I2>
+  bool equal_iterators(I1 first1, I1 last1, I2 first2, boolean_constant<false>)
+  {
+    return std::equal(first1, last1, first2);
+  }
+
+template<typename I1, typename I2>
+  std::pair<I1, I2> mismatch_iterators(I1 first1, I1 last1, I2 first2, boolean_constant<true>)
+  {
+    return mismatch_bytes(first1, last1, first2);
+  }
+
+template<typename I1, typename I2>
+  std::pair<I1, I2> mismatch_iterators(I1 first1, I1 last1, I2 first2, boolean_constant<false>)
+  {
+    return std::mismatch(first1, last1, first2);
+  }
+
+// Can ranges R1 and R2 be compared as bytes?
+template<typename R1, typename R2>
+  constexpr bool Bitwise_ranges()
+  {
+    return Contiguous_range<R1>()
+        && Contiguous_range<R2>()
+        && Bitwise_iterators<const Value_type<R1>*, const Value_type<R2>*>();
+  }
+
+}	// namespace impl
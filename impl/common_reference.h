@@ -0,0 +1,114 @@
+#ifndef CORE_H
+#error This file cannot be included directly. Include core.h
+#endif	// CORE_H
+
+// Common reference - a simplified form of C++20's common_reference.
+//
+// Common_type<T, U> decays its arguments, so the common type of int& and const int& is int,
+// and an iterator's reference type and its value type can only meet in a copy. The common
+// reference keeps references when it can:
+//
+//   1. If T and U are lvalue references, and the conditional operator on lvalues of the two
+//      types (with the cv-qualifiers of both) yields an lvalue, its type.
+//   2. Otherwise, if basic_common_reference is specialized for the unqualified types, its type.
+//      This is how a proxy reference names the type it shares with its value type.
+//   3. Otherwise, the type of the conditional operator on values of T and U.
+//   4. Otherwise, Common_type<T, U>.
+
+namespace impl {
+
+template<typename From, typename To>
+  struct copy_cv {
+    using type = To;
+  };
+
+template<typename From, typename To>
+  struct copy_cv<const From, To> {
+    using type = const To;
+  };
+
+template<typename From, typename To>
+  struct copy_cv<volatile From, To> {
+    using type = volatile To;
+  };
+
+template<typename From, typename To>
+  struct copy_cv<const volatile From, To> {
+    using type = const volatile To;
+  };
+
+template<typename From, typename To>
+  using Copy_cv = typename copy_cv<From, To>::type;
+
+// The type of `b ? t : u`, for expressions t and u of types T and U.
+template<typename T, typename U>
+  struct get_conditional_result {
+  private:
+    template<typename X, typename Y>
+      static decltype(true ? std::declval<X>() : std::declval<Y>()) check(int);
+
+    template<typename X, typename Y>
+      static substitution_failure check(...);
+
+  public:
+    using type = decltype(check<T, U>(0));
+  };
+
+template<typename T, typename U>
+  using Conditional_result = typename get_conditional_result<T, U>::type;
+
+template<typename T, typename U>
+  struct get_basic_common_reference {
+  private:
+    template<typename X, typename Y>
+      static typename basic_common_reference<X, Y>::type check(int);
+
+    template<typename X, typename Y>
+      static substitution_failure check(...);
+
+  public:
+    using type = decltype(check<Remove_cv<Remove_reference<T>>, Remove_cv<Remove_reference<U>>>(0));
+  };
+
+// Rule 1, for two lvalue references.
+template<typename T, typename U>
+  struct lvalue_common_reference {
+    using X = Remove_reference<T>;
+    using Y = Remove_reference<U>;
+    using C = Conditional_result<Copy_cv<Y, X>&, Copy_cv<X, Y>&>;
+
+    using type = Conditional<Lvalue_reference<C>(), C, substitution_failure>;
+  };
+
+// Take the first of the candidates that is not a substitution failure.
+template<typename... Ts>
+  struct first_success {
+    using type = substitution_failure;
+  };
+
+template<typename T, typename... Ts>
+  struct first_success<T, Ts...> {
+    using type = Conditional<Substitution_succeeded<T>(), T, typename first_success<Ts...>::type>;
+  };
+
+template<typename T, typename U,
+         bool = Lvalue_reference<T>() && Lvalue_reference<U>()>
+  struct get_common_reference {
+    using type = typename first_success<
+                   typename get_basic_common_reference<T, U>::type,
+                   Conditional_result<T, U>,
+                   Common_type<T, U>
+                 >::type;
+  };
+
+template<typename T, typename U>
+  struct get_common_reference<T, U, true> {
+    using type = typename first_success<
+                   typename lvalue_common_reference<T, U>::type,
+                   typename get_basic_common_reference<T, U>::type,
+                   Conditional_result<T, U>,
+                   Common_type<T, U>
+                 >::type;
+  };
+
+}	// namespace impl
@@ -1,6 +1,6 @@
-#ifndef CONSTRAINTS_H
-#error This file cannot be included directly. Include constraints.h
-#endif	// CONSTRAINTS_H
+#ifndef COMPARISON_H
+#error This file cannot be included directly. Include comparison.h
+#endif	// COMPARISON_H
 
 namespace impl {
 
@@ -50,4 +50,33 @@ template<typename T>
         && Has_greater_equal<T>() && Boolean<Greater_equal_result<T>>()
       > { };
 
+// Is R one of the comparison categories? They all convert to std::partial_ordering.
+template<typename R>
+  constexpr bool Comparison_category()
+  {
+#if defined(ESTD_HAS_THREE_WAY)
+    return Convertible<R, std::partial_ordering>();
+#else
+    return false;
+#endif
+  }
+
+template<typename T, typename U>
+  struct is_three_way_comparable
+    : boolean_constant<
+           Three_way_comparable<T>()
+        && Three_way_comparable<U>()
+        && Equality_comparable<T, U>()
+        && Weakly_ordered<T, U>()
+        && Has_three_way<T, U>() && Comparison_category<Three_way_result<T, U>>()
+        && Has_three_way<U, T>() && Comparison_category<Three_way_result<U, T>>()
+      > { };
+
+template<typename T>
+  struct is_three_way_comparable<T, T>
+    : boolean_constant<
+           Totally_ordered<T>()
+        && Has_three_way<T>() && Comparison_category<Three_way_result<T>>()
+      > { };
+
 }	// namespace impl
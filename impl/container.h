@@ -1,6 +1,6 @@
-#ifndef TRAITS_H
-#error This file cannot be included directly. Include traits.h
-#endif	// TRAITS_H
+#ifndef CONTAINER_TRAITS_H
+#error This file cannot be included directly. Include container_traits.h
+#endif	// CONTAINER_TRAITS_H
 
 // Container member types - pg. 896.
 
@@ -378,6 +378,18 @@ template<typename T>
     using type = decltype(check(std::declval<T>()));
   };
 
+template<typename T>
+  struct get_member_data_result {
+  private:
+    template<typename X>
+      static auto check(const X& x) -> decltype(x.data());
+
+    static substitution_failure check(...);
+
+  public:
+    using type = decltype(check(std::declval<T>()));
+  };
+
 template<typename T>
   struct get_member_at_result {
   private:
@@ -1,6 +1,6 @@
-#ifndef TRAITS_H
-#error This file cannot be included directly. Include traits.h
-#endif	// TRAITS_H
+#ifndef CONTAINER_TRAITS_H
+#error This file cannot be included directly. Include container_traits.h
+#endif	// CONTAINER_TRAITS_H
 
 // In the event that a type doesn't have an associated type (e.g., value_type),
 // we can try to deduce type trait we're looking for.
@@ -22,6 +22,10 @@
 //
 // If the conventional struct were used, a user couldn't overload the check() function
 // without modifying library code.
+//
+// Each overload a user adds is a candidate in every deduction, for every type. A user who
+// instead specializes value_type_traits, size_type_traits and so on (see traits.h) is never
+// deduced at all: the specialization takes precedence over this whole mechanism.
 
 namespace impl {
 
@@ -38,6 +38,32 @@ template<typename T>
   struct iterator_category_traits<T&&>
     : iterator_category_traits<T> { };
 
+// The associated types of a segmented iterator.
+
+template<typename T>
+  struct get_segment_iterator {
+  private:
+    template<typename X>
+      static typename segmented_iterator_traits<X>::segment_iterator check(const X&);
+
+    static substitution_failure check(...);
+
+  public:
+    using type = decltype(check(std::declval<T>()));
+  };
+
+template<typename T>
+  struct get_local_iterator {
+  private:
+    template<typename X>
+      static typename segmented_iterator_traits<X>::local_iterator check(const X&);
+
+    static substitution_failure check(...);
+
+  public:
+    using type = decltype(check(std::declval<T>()));
+  };
+
 template<typename T>
   struct get_std_begin_result {
   private:
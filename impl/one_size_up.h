@@ -1,6 +1,6 @@
-#ifndef TRAITS_H
-#error This file cannot be included directly. Include traits.h
-#endif	// TRAITS_H
+#ifndef CONTAINER_TRAITS_H
+#error This file cannot be included directly. Include container_traits.h
+#endif	// CONTAINER_TRAITS_H
 
 namespace impl {
 
@@ -1,6 +1,6 @@
-#ifndef TRAITS_H
-#error This file cannot be included directly. Include traits.h
-#endif	// TRAITS_H
+#ifndef OPERATORS_H
+#error This file cannot be included directly. Include operators.h
+#endif	// OPERATORS_H
 
 // The technique for determining the result type of an expression comes from pg. 800.
 // However, the actual code used here comes from the Origin library.
@@ -64,8 +64,8 @@ template<typename T, typename U>
 template<typename T>
   struct get_post_increment_result {
   private:
-    template<typename X, typename Y>
-      static auto check(X& x, Y&& y) -> decltype(x++);
+    template<typename X>
+      static auto check(X& x) -> decltype(x++);
 
     static substitution_failure check(...);
 
@@ -77,8 +77,8 @@ template<typename T>
 template<typename T>
   struct get_post_decrement_result {
   private:
-    template<typename X, typename Y>
-      static auto check(X& x, Y&& y) -> decltype(x--);
+    template<typename X>
+      static auto check(X& x) -> decltype(x--);
 
     static substitution_failure check(...);
 
@@ -90,8 +90,8 @@ template<typename T>
 template<typename T>
   struct get_pre_increment_result {
   private:
-    template<typename X, typename Y>
-      static auto check(X& x, Y&& y) -> decltype(--x);
+    template<typename X>
+      static auto check(X& x) -> decltype(++x);
 
     static substitution_failure check(...);
 
@@ -103,8 +103,8 @@ template<typename T>
 template<typename T>
   struct get_pre_decrement_result {
   private:
-    template<typename X, typename Y>
-      static auto check(X& x, Y&& y) -> decltype(--x);
+    template<typename X>
+      static auto check(X& x) -> decltype(--x);
 
     static substitution_failure check(...);
 
@@ -359,6 +359,27 @@ template<typename T, typename U>
     using type = decltype(check(std::declval<T>(), std::declval<U>()));
   };
 
+// Is t <=> u a valid expression?
+// Before C++20 the operator doesn't exist, so the answer is always no.
+#if defined(ESTD_HAS_THREE_WAY)
+template<typename T, typename U>
+  struct get_three_way_result {
+  private:
+    template<typename X, typename Y>
+      static auto check(X&& x, Y&& y) -> decltype(x <=> y);
+
+    static substitution_failure check(...);
+
+  public:
+    using type = decltype(check(std::declval<T>(), std::declval<U>()));
+  };
+#else
+template<typename T, typename U>
+  struct get_three_way_result {
+    using type = substitution_failure;
+  };
+#endif
+
 // Is t & u a valid expression?
 template<typename T, typename U>
   struct get_bitwise_and_result {
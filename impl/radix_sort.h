@@ -0,0 +1,190 @@
+#ifndef ALGORITHM_H
+#error This file cannot be included directly. Include algorithm.h
+#endif	// ALGORITHM_H
+
+// LSD radix sort.
+//
+// Each key is mapped to an unsigned integer whose natural order is the order of the key.
+// The elements are then distributed one byte at a time, least significant byte first,
+// between the input range and a buffer. Counting sort is stable, so after the last pass
+// the elements are sorted by the whole key.
+//
+// All the byte histograms are built in a single pass before any element moves. A byte
+// position at which every key agrees needs no pass at all; this is common for small
+// values stored in wide types, such as ids that fit in 40 bits.
+
+namespace impl {
+
+// Can values of type T be used as radix sort keys?
+// bool is left to comparison sort, because Make_unsigned<bool> is ill-formed.
+// long double is left out because its padding bytes are not part of the value.
+template<typename T>
+  constexpr bool Radix_key()
+  {
+    return (Integral<T>() && !Same<Remove_cv<T>, bool>())
+        || (Floating_point<T>()
+         && std::numeric_limits<T>::is_iec559
+         && (sizeof(T) == 4 || sizeof(T) == 8));
+  }
+
+// radix_traits<T>::bits(x) maps x to an unsigned integer that sorts in the same order as x.
+
+template<typename T,
+         bool = Integral<T>(),
+	 bool = Signed<T>()>
+  struct radix_traits;
+
+// Unsigned integers are their own keys.
+template<typename T>
+  struct radix_traits<T, true, false> {
+    using key_type = Make_unsigned<T>;
+
+    static key_type bits(T x)
+    {
+      return static_cast<key_type>(x);
+    }
+  };
+
+// Signed integers are two's complement, so flipping the sign bit puts the
+// negative values below the positive ones.
+template<typename T>
+  struct radix_traits<T, true, true> {
+    using key_type = Make_unsigned<T>;
+
+    static key_type bits(T x)
+    {
+      return static_cast<key_type>(static_cast<key_type>(x) ^ (key_type(1) << (sizeof(T) * CHAR_BIT - 1)));
+    }
+  };
+
+// IEEE 754 values are sign and magnitude. Flipping the sign bit of a positive value puts it
+// above every negative value; flipping every bit of a negative value reverses the order of the
+// magnitudes. -0.0 sorts just below 0.0, and NaNs go to either end according to their sign.
+template<typename T>
+  struct radix_traits<T, false, true> {
+    using key_type = Conditional<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+
+    static key_type bits(T x)
+    {
+      const unsigned top = sizeof(T) * CHAR_BIT - 1;
+      key_type u;
+      std::memcpy(&u, &x, sizeof(u));
+      return u ^ (static_cast<key_type>(0 - (u >> top)) | (key_type(1) << top));
+    }
+  };
+
+// Below this many elements, comparison sort wins over the fixed cost of the histograms.
+constexpr std::size_t radix_sort_threshold = 256;
+
+// The key of a value sorted by itself.
+struct identity_key {
+  template<typename T>
+    const T& operator()(const T& x) const { return x; }
+};
+
+// Compares values by their keys; used where radix sort does not apply.
+template<typename K>
+  struct key_less {
+    K key;
+
+    template<typename T>
+      bool operator()(const T& a, const T& b) const { return key(a) < key(b); }
+  };
+
+// Move the n elements of src to dst, ordered by byte `shift / 8` of their keys.
+template<typename Traits, typename I, typename O, typename K>
+  void radix_scatter(I src, O dst, std::size_t n, K& key, const std::size_t* count, unsigned shift)
+  {
+    std::size_t offset[256];
+    std::size_t sum = 0;
+    for (unsigned b = 0; b != 256; ++b) {
+      offset[b] = sum;
+      sum += count[b];
+    }
+
+    for (std::size_t i = 0; i != n; ++i) {
+      auto&& x = src[i];
+      unsigned b = (Traits::bits(key(x)) >> shift) & 0xff;
+      dst[offset[b]++] = std::move(x);
+    }
+  }
+
+template<typename I, typename K>
+  void radix_sort(I first, I last, K key)
+  {
+    using V = Value_type<I>;
+    using Traits = radix_traits<Decay<Result_of<K(const V&)>>>;
+    using U = typename Traits::key_type;
+    static constexpr std::size_t passes = sizeof(U);
+
+    const std::size_t n = last - first;
+
+    std::size_t count[passes][256] = { };
+    for (I i = first; i != last; ++i) {
+      U u = Traits::bits(key(*i));
+      for (std::size_t p = 0; p != passes; ++p)
+        ++count[p][(u >> (p * 8)) & 0xff];
+    }
+
+    // Any element will do to spot the bytes on which all the keys agree.
+    const U u0 = Traits::bits(key(*first));
+
+    // new V[n] leaves arithmetic values uninitialized, which saves a pass over the buffer.
+    std::unique_ptr<V[]> buffer(new V[n]);
+    bool in_buffer = false;
+    for (std::size_t p = 0; p != passes; ++p) {
+      unsigned shift = static_cast<unsigned>(p * 8);
+      if (count[p][(u0 >> shift) & 0xff] == n)
+        continue;
+
+      if (in_buffer)
+        radix_scatter<Traits>(buffer.get(), first, n, key, count[p], shift);
+      else
+        radix_scatter<Traits>(first, buffer.get(), n, key, count[p], shift);
+      in_buffer = !in_buffer;
+    }
+
+    if (in_buffer)
+      std::move(buffer.get(), buffer.get() + n, first);
+  }
+
+// Sort by key with comparisons.
+
+template<typename I, typename K>
+  void comparison_sort(I first, I last, K key, boolean_constant<false>)
+  {
+    std::sort(first, last, key_less<K>{key});
+  }
+
+template<typename I, typename K>
+  void comparison_sort(I first, I last, K key, boolean_constant<true>)
+  {
+    three_way_sort(first, last, key);
+  }
+
+// Sort by key. The radix path needs a key type it understands and a buffer of values.
+
+template<typename I, typename K>
+  void sort_by_key(I first, I last, K key, boolean_constant<false>)
+  {
+    comparison_sort(first, last, key, boolean_constant<Three_way_sortable<I, K>()>{});
+  }
+
+template<typename I, typename K>
+  void sort_by_key(I first, I last, K key, boolean_constant<true>)
+  {
+    if (std::size_t(last - first) < radix_sort_threshold)
+      std::sort(first, last, key_less<K>{key});
+    else
+      radix_sort(first, last, key);
+  }
+
+template<typename I, typename K>
+  constexpr bool Radix_sortable()
+  {
+    return Radix_key<Decay<Result_of<K(const Value_type<I>&)>>>()
+        && Default_constructible<Value_type<I>>()
+        && Move_assignable<Value_type<I>>();
+  }
+
+}	// namespace impl
@@ -0,0 +1,215 @@
+#ifndef NUMERIC_H
+#error This file cannot be included directly. Include numeric.h
+#endif	// NUMERIC_H
+
+// Reduction kernels.
+//
+// A sum over a contiguous array is split among `lanes` independent accumulators.
+// A single accumulator makes every addition wait for the one before it; with eight, the
+// additions are independent, so the compiler can keep them in SIMD registers and the
+// loop runs at the throughput of the adder rather than at its latency.
+//
+// Integer addition is associative, so the order of the additions does not matter.
+// Floating point addition is not. For floating point arrays we use pairwise summation:
+// the array is halved until the pieces are short, each piece is summed with the unrolled
+// kernel, and the partial sums are added back up as a tree. The rounding error then grows
+// with log n rather than n, at the speed of the plain unrolled loop. Ranges that aren't
+// contiguous can't be halved cheaply; they use Neumaier's variant of Kahan summation.
+
+namespace impl {
+
+// The type in which values of type T are accumulated.
+// Integers are promoted as for any arithmetic and then widened with One_size_up, so that
+// sums of int32 don't overflow, and neither do sums of bytes or bools.
+// Floating point values are accumulated in at least double precision.
+template<typename T,
+         bool = Integral<T>()>
+  struct accumulator_type {
+    using type = Conditional<(sizeof(T) > sizeof(double)), T, double>;
+  };
+
+template<typename T>
+  struct accumulator_type<T, true> {
+    using type = One_size_up<Unary_plus_result<T>>;
+  };
+
+constexpr std::size_t lanes = 8;
+
+// Below this many terms, a floating point sum is not split any further.
+constexpr std::size_t pairwise_block = 128;
+
+// The terms of a sum: p[i].
+template<typename A, typename T>
+  struct sum_term {
+    const T* p;
+
+    A operator()(std::size_t i) const { return static_cast<A>(p[i]); }
+  };
+
+// The terms of a dot product: a[i] * b[i].
+template<typename A, typename T, typename U>
+  struct dot_term {
+    const T* a;
+    const U* b;
+
+    A operator()(std::size_t i) const { return static_cast<A>(a[i]) * static_cast<A>(b[i]); }
+  };
+
+// Sum term(first), ..., term(first + n - 1) with `lanes` accumulators.
+template<typename A, typename F>
+  A unrolled_sum(F term, std::size_t first, std::size_t n)
+  {
+    A acc[lanes] = { };
+    std::size_t i = first;
+    const std::size_t last = first + n;
+    for (; last - i >= lanes; i += lanes)
+      for (std::size_t j = 0; j != lanes; ++j)
+        acc[j] += term(i + j);
+
+    A tail = A();
+    for (; i != last; ++i)
+      tail += term(i);
+
+    // Combine as a tree, so the floating point error stays balanced.
+    return ((acc[0] + acc[1]) + (acc[2] + acc[3]))
+         + ((acc[4] + acc[5]) + (acc[6] + acc[7]))
+         + tail;
+  }
+
+template<typename A, typename F>
+  A pairwise_sum(F term, std::size_t first, std::size_t n)
+  {
+    if (n <= pairwise_block)
+      return unrolled_sum<A>(term, first, n);
+
+    // Keep the split on a multiple of lanes, so only the last piece has a tail.
+    std::size_t half = n / 2;
+    half -= half % lanes;
+    return pairwise_sum<A>(term, first, half)
+         + pairwise_sum<A>(term, first + half, n - half);
+  }
+
+// Contiguous sums. The flag says whether A is a floating point type.
+
+template<typename A, typename F>
+  A contiguous_sum(F term, std::size_t n, boolean_constant<false>)
+  {
+    return unrolled_sum<A>(term, 0, n);
+  }
+
+template<typename A, typename F>
+  A contiguous_sum(F term, std::size_t n, boolean_constant<true>)
+  {
+    return pairwise_sum<A>(term, 0, n);
+  }
+
+// Neumaier summation for ranges that can only be walked once.
+template<typename A>
+  struct compensated_accumulator {
+    A sum = A();
+    A error = A();
+
+    void add(A x)
+    {
+      A t = sum + x;
+      if ((sum < 0 ? -sum : sum) >= (x < 0 ? -x : x))
+        error += (sum - t) + x;
+      else
+        error += (x - t) + sum;
+      sum = t;
+    }
+
+    A result() const { return sum + error; }
+  };
+
+// For integers, the plain sum is exact.
+template<typename A>
+  struct plain_accumulator {
+    A sum = A();
+
+    void add(A x) { sum += x; }
+
+    A result() const { return sum; }
+  };
+
+template<typename A>
+  using Sequential_accumulator = Conditional<Floating_point<A>(), compensated_accumulator<A>, plain_accumulator<A>>;
+
+// Sum [first, last), counting the terms in n. last may be a sentinel.
+template<typename A, typename I, typename S>
+  A sequential_sum(I first, S last, std::size_t& n)
+  {
+    Sequential_accumulator<A> acc;
+    for (n = 0; first != last; ++first, ++n)
+      acc.add(static_cast<A>(*first));
+    return acc.result();
+  }
+
+template<typename A, typename I1, typename S1, typename I2>
+  A sequential_dot(I1 first1, S1 last1, I2 first2)
+  {
+    Sequential_accumulator<A> acc;
+    for (; first1 != last1; ++first1, ++first2)
+      acc.add(static_cast<A>(*first1) * static_cast<A>(*first2));
+    return acc.result();
+  }
+
+// Sum dispatch: contiguous storage gets the unrolled kernels, everything else is walked once.
+
+template<typename A, typename I>
+  A sum(I first, I last, std::size_t& n, boolean_constant<true>)
+  {
+    n = last - first;
+    return contiguous_sum<A>(sum_term<A, Value_type<I>>{first}, n, boolean_constant<Floating_point<A>()>{});
+  }
+
+template<typename A, typename I>
+  A sum(I first, I last, std::size_t& n, boolean_constant<false>)
+  {
+    return sequential_sum<A>(first, last, n);
+  }
+
+template<typename A, typename R>
+  A sum_range(const R& r, std::size_t& n, boolean_constant<true>)
+  {
+    const auto* p = contiguous_data(r);
+    return sum<A>(p, p + contiguous_size(r), n, boolean_constant<true>{});
+  }
+
+template<typename A, typename R>
+  A sum_range(const R& r, std::size_t& n, boolean_constant<false>)
+  {
+    using std::begin;
+    using std::end;
+    return sequential_sum<A>(begin(r), end(r), n);
+  }
+
+template<typename A, typename I1, typename I2>
+  A dot(I1 first1, I1 last1, I2 first2, boolean_constant<true>)
+  {
+    using Term = dot_term<A, Value_type<I1>, Value_type<I2>>;
+    return contiguous_sum<A>(Term{first1, first2}, last1 - first1, boolean_constant<Floating_point<A>()>{});
+  }
+
+template<typename A, typename I1, typename I2>
+  A dot(I1 first1, I1 last1, I2 first2, boolean_constant<false>)
+  {
+    return sequential_dot<A>(first1, last1, first2);
+  }
+
+template<typename A, typename R1, typename R2>
+  A dot_range(const R1& r1, const R2& r2, boolean_constant<true>)
+  {
+    const auto* a = contiguous_data(r1);
+    return dot<A>(a, a + contiguous_size(r1), contiguous_data(r2), boolean_constant<true>{});
+  }
+
+template<typename A, typename R1, typename R2>
+  A dot_range(const R1& r1, const R2& r2, boolean_constant<false>)
+  {
+    using std::begin;
+    using std::end;
+    return sequential_dot<A>(begin(r1), end(r1), begin(r2));
+  }
+
+}	// namespace impl
@@ -1,6 +1,6 @@
-#ifndef TRAITS_H
-#error This file cannot be included directly. Include traits.h
-#endif	// TRAITS_H
+#ifndef CORE_H
+#error This file cannot be included directly. Include core.h
+#endif	// CORE_H
 
 namespace impl {
 
@@ -22,6 +22,10 @@ namespace impl {
 // invoke provides overloads of a function fn which tests each invocation and returns its result type.
 // invoke also provides an overload returning substitution_failure the argument to fn matches
 // none of the invocations.
+//
+// The overloads that match an invocation also have bodies, so invoke::fn(f, args...) performs
+// the call. The type-erased callables in functional.h call through it, which guarantees that
+// they accept exactly the calls that Has_call and Result_of describe.
 
 struct invoke {
   // Matches none of the invocations.
@@ -30,40 +34,92 @@ struct invoke {
   // (t1.*f)(t2, ..., Tn)
   template<typename F, typename C, typename... Args>
     static auto fn(F f, C&& c, Args&&... args)
-      -> decltype((std::forward<C>(c).*f)(std::forward<Args>(args)...));
+      -> decltype((std::forward<C>(c).*f)(std::forward<Args>(args)...))
+    {
+      return (std::forward<C>(c).*f)(std::forward<Args>(args)...);
+    }
 
   // ((*t1).*f)(t2, ..., tN)
   template<typename F, typename C, typename... Args>
     static auto fn(F f, C&& c, Args&&... args)
-      -> decltype(((*std::forward<C>(c)).*f)(std::forward<Args>(args)...));
+      -> decltype(((*std::forward<C>(c)).*f)(std::forward<Args>(args)...))
+    {
+      return ((*std::forward<C>(c)).*f)(std::forward<Args>(args)...);
+    }
 
   // t1.*f
   template<typename F, typename C>
     static auto fn(F f, C&& c)
-      -> decltype(std::forward<C>(c).*f);
+      -> decltype(std::forward<C>(c).*f)
+    {
+      return std::forward<C>(c).*f;
+    }
 
   // (*t1).*f
   template<typename F, typename C>
     static auto fn(F f, C&& c)
-      -> decltype((*std::forward<C>(c)).*f);
+      -> decltype((*std::forward<C>(c)).*f)
+    {
+      return (*std::forward<C>(c)).*f;
+    }
 
   // f(t1, t2, ..., tN)
+  // The arguments are forwarded references. Taking them by value would turn every
+  // lvalue argument into an rvalue, and calls to functions taking T& would not match.
   template<typename F, typename... Args>
-    static auto fn(F&& f, Args... args)
-      -> decltype(std::forward<F>(f)(std::forward<Args>(args)...));
+    static auto fn(F&& f, Args&&... args)
+      -> decltype(std::forward<F>(f)(std::forward<Args>(args)...))
+    {
+      return std::forward<F>(f)(std::forward<Args>(args)...);
+    }
 };
 
-// An interface for invoke::fn()
+// An interface for invoke::fn().
+//
+// Only a member pointer can match the first four overloads of invoke::fn, since .* applies to
+// nothing else. So the member pointer types are picked out by partial specialization, and go
+// to invoke::fn. Everything else - functions, function objects and lambdas, which are most of
+// what the constraints see - is tested with a single call expression, instead of by overload
+// resolution against all of invoke::fn.
+
 template<typename F, typename... Args>
   struct invoke_result {
-    using type = decltype(invoke::fn(std::declval<F>(), std::declval<Args>()...));
+  private:
+    template<typename G>
+      static decltype(std::declval<G>()(std::declval<Args>()...)) check(int);
+
+    template<typename G>
+      static substitution_failure check(...);
+
+  public:
+    using type = decltype(check<F>(0));
   };
 
-template<typename F>
-  struct invoke_result<F> {
-    using type = decltype(invoke::fn(std::declval<F>()));
+template<typename F, typename... Args>
+  struct member_invoke_result {
+    using type = decltype(invoke::fn(std::declval<F>(), std::declval<Args>()...));
   };
 
+template<typename T, typename C, typename... Args>
+  struct invoke_result<T C::*, Args...>
+    : member_invoke_result<T C::*, Args...> { };
+
+template<typename T, typename C, typename... Args>
+  struct invoke_result<T C::* const, Args...>
+    : member_invoke_result<T C::*, Args...> { };
+
+template<typename T, typename C, typename... Args>
+  struct invoke_result<T C::*&, Args...>
+    : member_invoke_result<T C::*, Args...> { };
+
+template<typename T, typename C, typename... Args>
+  struct invoke_result<T C::* const&, Args...>
+    : member_invoke_result<T C::*, Args...> { };
+
+template<typename T, typename C, typename... Args>
+  struct invoke_result<T C::*&&, Args...>
+    : member_invoke_result<T C::*, Args...> { };
+
 template<typename F, typename... Args>
   using Invoke = typename invoke_result<F, Args...>::type;
 
@@ -86,4 +142,38 @@ template<typename... Args>
     using type = substitution_failure;
   };
 
+// has_call is true when result_of is not a substitution failure. Compilers with the
+// __is_invocable builtin (GCC 14 and later) answer that for plain calls without instantiating
+// anything. Member pointers stay with invoke::fn, so that Has_call accepts exactly the calls
+// invoke::fn can make.
+
+#if defined(__has_builtin)
+#if __has_builtin(__is_invocable)
+#define ESTD_HAS_IS_INVOCABLE
+#endif
+#endif
+
+template<typename T>
+  struct has_call
+    : substitution_succeeded<typename result_of<T>::type> { };
+
+#if defined(ESTD_HAS_IS_INVOCABLE)
+// Selected by whether F is a member pointer, so that only the chosen test is instantiated.
+template<bool Member_pointer, typename F, typename... Args>
+  struct has_call_of
+    : substitution_succeeded<Invoke<F, Args...>> { };
+
+template<typename F, typename... Args>
+  struct has_call_of<false, F, Args...>
+    : boolean_constant<__is_invocable(F, Args...)> { };
+
+template<typename F, typename... Args>
+  struct has_call<F(Args...)>
+    : has_call_of<std::is_member_pointer<Remove_reference<F>>::value, F, Args...> { };
+
+template<typename... Args>
+  struct has_call<void(Args...)>
+    : std::false_type { };
+#endif
+
 }	// namespace impl
@@ -0,0 +1,131 @@
+#ifndef ALGORITHM_H
+#error This file cannot be included directly. Include algorithm.h
+#endif	// ALGORITHM_H
+
+// Hierarchical algorithms over segmented iterators.
+//
+// [first, last) is split into the local ranges of its segments, and each local range is
+// handed to the standard algorithm, or to a plain loop. When the local iterators are
+// pointers, the inner loops are the ones the library has for arrays: memmove for std::copy,
+// memset for std::fill.
+
+namespace impl {
+
+// Visit the local ranges of [first, last) in order. visit(f, l) returns the position at
+// which it stopped; if that isn't l, the walk ends there and the position is returned as
+// an I. Otherwise the result is last.
+template<typename I, typename V>
+  I for_each_segment(I first, I last, V visit)
+  {
+    using T = segmented_iterator_traits<I>;
+
+    Segment_iterator<I> s = T::segment(first);
+    Segment_iterator<I> sl = T::segment(last);
+    Local_iterator<I> l = T::local(first);
+
+    for (; s != sl; ++s, l = T::begin(s)) {
+      Local_iterator<I> e = T::end(s);
+      Local_iterator<I> p = visit(l, e);
+      if (p != e)
+        return T::compose(s, p);
+    }
+
+    Local_iterator<I> e = T::local(last);
+    Local_iterator<I> p = visit(l, e);
+    return p != e ? T::compose(s, p) : last;
+  }
+
+template<typename L, typename F>
+  struct for_each_visitor {
+    F& f;
+
+    L operator()(L first, L last) const
+    {
+      for (; first != last; ++first)
+        f(*first);
+      return last;
+    }
+  };
+
+template<typename L, typename T>
+  struct find_visitor {
+    const T& value;
+
+    L operator()(L first, L last) const { return std::find(first, last, value); }
+  };
+
+template<typename L, typename O>
+  struct copy_visitor {
+    O& out;
+
+    L operator()(L first, L last) const
+    {
+      out = std::copy(first, last, out);
+      return last;
+    }
+  };
+
+template<typename L, typename T>
+  struct fill_visitor {
+    const T& value;
+
+    L operator()(L first, L last) const
+    {
+      std::fill(first, last, value);
+      return last;
+    }
+  };
+
+// The bounded algorithms, for segmented iterators and for the others.
+
+template<typename I, typename F>
+  F for_each_bounded(I first, I last, F f, boolean_constant<true>)
+  {
+    impl::for_each_segment(first, last, for_each_visitor<Local_iterator<I>, F>{f});
+    return f;
+  }
+
+template<typename I, typename F>
+  F for_each_bounded(I first, I last, F f, boolean_constant<false>)
+  {
+    return std::for_each(first, last, std::move(f));
+  }
+
+template<typename I, typename T>
+  I find_bounded(I first, I last, const T& value, boolean_constant<true>)
+  {
+    return impl::for_each_segment(first, last, find_visitor<Local_iterator<I>, T>{value});
+  }
+
+template<typename I, typename T>
+  I find_bounded(I first, I last, const T& value, boolean_constant<false>)
+  {
+    return std::find(first, last, value);
+  }
+
+template<typename I, typename O>
+  O copy_bounded(I first, I last, O out, boolean_constant<true>)
+  {
+    impl::for_each_segment(first, last, copy_visitor<Local_iterator<I>, O>{out});
+    return out;
+  }
+
+template<typename I, typename O>
+  O copy_bounded(I first, I last, O out, boolean_constant<false>)
+  {
+    return std::copy(first, last, out);
+  }
+
+template<typename I, typename T>
+  void fill_bounded(I first, I last, const T& value, boolean_constant<true>)
+  {
+    impl::for_each_segment(first, last, fill_visitor<Local_iterator<I>, T>{value});
+  }
+
+template<typename I, typename T>
+  void fill_bounded(I first, I last, const T& value, boolean_constant<false>)
+  {
+    std::fill(first, last, value);
+  }
+
+}	// namespace impl
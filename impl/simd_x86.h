@@ -0,0 +1,354 @@
+#ifndef SIMD_H
+#error This file cannot be included directly. Include simd.h
+#endif	// SIMD_H
+
+// The x86 vector register backends for simd and simd_mask.
+//
+// Each specialization of simd_abi<T, N> maps the operations onto the intrinsics of one
+// register width, with the interface of scalar_simd_abi. The SSE and AVX backends keep a mask
+// as a register of all-ones and all-zeros lanes, as their compare instructions produce it;
+// AVX-512 compares into a k-register, which is an integer with one bit per lane.
+//
+// SSE2 lacks some int32 operations (mullo, min and max, blendv), which are built from the
+// operations it has unless SSE4.1 is enabled too. No x86 backend divides integers, so
+// int32 division goes one lane at a time.
+
+namespace impl {
+
+// SSE2: 4 floats, 2 doubles, 4 int32s.
+
+template<>
+  struct simd_abi<float, 4> {
+    using reg = __m128;
+    using mask = __m128;
+
+    static reg load(const float* p) { return _mm_loadu_ps(p); }
+    static void store(reg a, float* p) { _mm_storeu_ps(p, a); }
+    static reg broadcast(float x) { return _mm_set1_ps(x); }
+
+    static reg add(reg a, reg b) { return _mm_add_ps(a, b); }
+    static reg sub(reg a, reg b) { return _mm_sub_ps(a, b); }
+    static reg mul(reg a, reg b) { return _mm_mul_ps(a, b); }
+    static reg div(reg a, reg b) { return _mm_div_ps(a, b); }
+    static reg neg(reg a) { return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+    static reg min(reg a, reg b) { return _mm_min_ps(b, a); }
+    static reg max(reg a, reg b) { return _mm_max_ps(b, a); }
+
+    static mask eq(reg a, reg b) { return _mm_cmpeq_ps(a, b); }
+    static mask ne(reg a, reg b) { return _mm_cmpneq_ps(a, b); }
+    static mask lt(reg a, reg b) { return _mm_cmplt_ps(a, b); }
+    static mask le(reg a, reg b) { return _mm_cmple_ps(a, b); }
+
+    static reg select(mask m, reg a, reg b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+
+    static mask mask_and(mask a, mask b) { return _mm_and_ps(a, b); }
+    static mask mask_or(mask a, mask b) { return _mm_or_ps(a, b); }
+    static mask mask_xor(mask a, mask b) { return _mm_xor_ps(a, b); }
+    static mask mask_not(mask a) { return _mm_xor_ps(a, mask_broadcast(true)); }
+    static mask mask_broadcast(bool b) { return _mm_castsi128_ps(_mm_set1_epi32(-int(b))); }
+    static std::uint64_t mask_bits(mask m) { return unsigned(_mm_movemask_ps(m)); }
+  };
+
+template<>
+  struct simd_abi<double, 2> {
+    using reg = __m128d;
+    using mask = __m128d;
+
+    static reg load(const double* p) { return _mm_loadu_pd(p); }
+    static void store(reg a, double* p) { _mm_storeu_pd(p, a); }
+    static reg broadcast(double x) { return _mm_set1_pd(x); }
+
+    static reg add(reg a, reg b) { return _mm_add_pd(a, b); }
+    static reg sub(reg a, reg b) { return _mm_sub_pd(a, b); }
+    static reg mul(reg a, reg b) { return _mm_mul_pd(a, b); }
+    static reg div(reg a, reg b) { return _mm_div_pd(a, b); }
+    static reg neg(reg a) { return _mm_xor_pd(a, _mm_set1_pd(-0.0)); }
+    static reg min(reg a, reg b) { return _mm_min_pd(b, a); }
+    static reg max(reg a, reg b) { return _mm_max_pd(b, a); }
+
+    static mask eq(reg a, reg b) { return _mm_cmpeq_pd(a, b); }
+    static mask ne(reg a, reg b) { return _mm_cmpneq_pd(a, b); }
+    static mask lt(reg a, reg b) { return _mm_cmplt_pd(a, b); }
+    static mask le(reg a, reg b) { return _mm_cmple_pd(a, b); }
+
+    static reg select(mask m, reg a, reg b) { return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b)); }
+
+    static mask mask_and(mask a, mask b) { return _mm_and_pd(a, b); }
+    static mask mask_or(mask a, mask b) { return _mm_or_pd(a, b); }
+    static mask mask_xor(mask a, mask b) { return _mm_xor_pd(a, b); }
+    static mask mask_not(mask a) { return _mm_xor_pd(a, mask_broadcast(true)); }
+    static mask mask_broadcast(bool b) { return _mm_castsi128_pd(_mm_set1_epi32(-int(b))); }
+    static std::uint64_t mask_bits(mask m) { return unsigned(_mm_movemask_pd(m)); }
+  };
+
+template<>
+  struct simd_abi<std::int32_t, 4> {
+    using reg = __m128i;
+    using mask = __m128i;
+
+    static reg load(const std::int32_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static void store(reg a, std::int32_t* p) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), a); }
+    static reg broadcast(std::int32_t x) { return _mm_set1_epi32(x); }
+
+    static reg add(reg a, reg b) { return _mm_add_epi32(a, b); }
+    static reg sub(reg a, reg b) { return _mm_sub_epi32(a, b); }
+    static reg div(reg a, reg b) { return divide_lanes<std::int32_t, 4, simd_abi>(a, b); }
+    static reg neg(reg a) { return _mm_sub_epi32(_mm_setzero_si128(), a); }
+
+#if defined(__SSE4_1__)
+    static reg mul(reg a, reg b) { return _mm_mullo_epi32(a, b); }
+    static reg min(reg a, reg b) { return _mm_min_epi32(a, b); }
+    static reg max(reg a, reg b) { return _mm_max_epi32(a, b); }
+    static reg select(mask m, reg a, reg b) { return _mm_blendv_epi8(b, a, m); }
+#else
+    // Multiply the even lanes and the odd lanes as 64-bit products, and keep the low halves.
+    static reg mul(reg a, reg b)
+    {
+      __m128i even = _mm_mul_epu32(a, b);
+      __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+      return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                                _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+    }
+
+    static reg min(reg a, reg b) { return select(lt(b, a), b, a); }
+    static reg max(reg a, reg b) { return select(lt(a, b), b, a); }
+    static reg select(mask m, reg a, reg b) { return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b)); }
+#endif
+
+    static reg bit_and(reg a, reg b) { return _mm_and_si128(a, b); }
+    static reg bit_or(reg a, reg b) { return _mm_or_si128(a, b); }
+    static reg bit_xor(reg a, reg b) { return _mm_xor_si128(a, b); }
+    static reg bit_not(reg a) { return _mm_xor_si128(a, _mm_set1_epi32(-1)); }
+
+    static mask eq(reg a, reg b) { return _mm_cmpeq_epi32(a, b); }
+    static mask ne(reg a, reg b) { return bit_not(eq(a, b)); }
+    static mask lt(reg a, reg b) { return _mm_cmplt_epi32(a, b); }
+    static mask le(reg a, reg b) { return bit_not(_mm_cmpgt_epi32(a, b)); }
+
+    static mask mask_and(mask a, mask b) { return _mm_and_si128(a, b); }
+    static mask mask_or(mask a, mask b) { return _mm_or_si128(a, b); }
+    static mask mask_xor(mask a, mask b) { return _mm_xor_si128(a, b); }
+    static mask mask_not(mask a) { return bit_not(a); }
+    static mask mask_broadcast(bool b) { return _mm_set1_epi32(-int(b)); }
+    static std::uint64_t mask_bits(mask m) { return unsigned(_mm_movemask_ps(_mm_castsi128_ps(m))); }
+  };
+
+#if defined(__AVX__)
+// AVX: 8 floats, 4 doubles.
+
+template<>
+  struct simd_abi<float, 8> {
+    using reg = __m256;
+    using mask = __m256;
+
+    static reg load(const float* p) { return _mm256_loadu_ps(p); }
+    static void store(reg a, float* p) { _mm256_storeu_ps(p, a); }
+    static reg broadcast(float x) { return _mm256_set1_ps(x); }
+
+    static reg add(reg a, reg b) { return _mm256_add_ps(a, b); }
+    static reg sub(reg a, reg b) { return _mm256_sub_ps(a, b); }
+    static reg mul(reg a, reg b) { return _mm256_mul_ps(a, b); }
+    static reg div(reg a, reg b) { return _mm256_div_ps(a, b); }
+    static reg neg(reg a) { return _mm256_xor_ps(a, _mm256_set1_ps(-0.0f)); }
+    static reg min(reg a, reg b) { return _mm256_min_ps(b, a); }
+    static reg max(reg a, reg b) { return _mm256_max_ps(b, a); }
+
+    static mask eq(reg a, reg b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+    static mask ne(reg a, reg b) { return _mm256_cmp_ps(a, b, _CMP_NEQ_UQ); }
+    static mask lt(reg a, reg b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static mask le(reg a, reg b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+
+    static reg select(mask m, reg a, reg b) { return _mm256_blendv_ps(b, a, m); }
+
+    static mask mask_and(mask a, mask b) { return _mm256_and_ps(a, b); }
+    static mask mask_or(mask a, mask b) { return _mm256_or_ps(a, b); }
+    static mask mask_xor(mask a, mask b) { return _mm256_xor_ps(a, b); }
+    static mask mask_not(mask a) { return _mm256_xor_ps(a, mask_broadcast(true)); }
+    static mask mask_broadcast(bool b) { return _mm256_castsi256_ps(_mm256_set1_epi32(-int(b))); }
+    static std::uint64_t mask_bits(mask m) { return unsigned(_mm256_movemask_ps(m)); }
+  };
+
+template<>
+  struct simd_abi<double, 4> {
+    using reg = __m256d;
+    using mask = __m256d;
+
+    static reg load(const double* p) { return _mm256_loadu_pd(p); }
+    static void store(reg a, double* p) { _mm256_storeu_pd(p, a); }
+    static reg broadcast(double x) { return _mm256_set1_pd(x); }
+
+    static reg add(reg a, reg b) { return _mm256_add_pd(a, b); }
+    static reg sub(reg a, reg b) { return _mm256_sub_pd(a, b); }
+    static reg mul(reg a, reg b) { return _mm256_mul_pd(a, b); }
+    static reg div(reg a, reg b) { return _mm256_div_pd(a, b); }
+    static reg neg(reg a) { return _mm256_xor_pd(a, _mm256_set1_pd(-0.0)); }
+    static reg min(reg a, reg b) { return _mm256_min_pd(b, a); }
+    static reg max(reg a, reg b) { return _mm256_max_pd(b, a); }
+
+    static mask eq(reg a, reg b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+    static mask ne(reg a, reg b) { return _mm256_cmp_pd(a, b, _CMP_NEQ_UQ); }
+    static mask lt(reg a, reg b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+    static mask le(reg a, reg b) { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+
+    static reg select(mask m, reg a, reg b) { return _mm256_blendv_pd(b, a, m); }
+
+    static mask mask_and(mask a, mask b) { return _mm256_and_pd(a, b); }
+    static mask mask_or(mask a, mask b) { return _mm256_or_pd(a, b); }
+    static mask mask_xor(mask a, mask b) { return _mm256_xor_pd(a, b); }
+    static mask mask_not(mask a) { return _mm256_xor_pd(a, mask_broadcast(true)); }
+    static mask mask_broadcast(bool b) { return _mm256_castsi256_pd(_mm256_set1_epi32(-int(b))); }
+    static std::uint64_t mask_bits(mask m) { return unsigned(_mm256_movemask_pd(m)); }
+  };
+#endif	// __AVX__
+
+#if defined(__AVX2__)
+// AVX2: 8 int32s.
+
+template<>
+  struct simd_abi<std::int32_t, 8> {
+    using reg = __m256i;
+    using mask = __m256i;
+
+    static reg load(const std::int32_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    static void store(reg a, std::int32_t* p) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), a); }
+    static reg broadcast(std::int32_t x) { return _mm256_set1_epi32(x); }
+
+    static reg add(reg a, reg b) { return _mm256_add_epi32(a, b); }
+    static reg sub(reg a, reg b) { return _mm256_sub_epi32(a, b); }
+    static reg mul(reg a, reg b) { return _mm256_mullo_epi32(a, b); }
+    static reg div(reg a, reg b) { return divide_lanes<std::int32_t, 8, simd_abi>(a, b); }
+    static reg neg(reg a) { return _mm256_sub_epi32(_mm256_setzero_si256(), a); }
+    static reg min(reg a, reg b) { return _mm256_min_epi32(a, b); }
+    static reg max(reg a, reg b) { return _mm256_max_epi32(a, b); }
+
+    static reg bit_and(reg a, reg b) { return _mm256_and_si256(a, b); }
+    static reg bit_or(reg a, reg b) { return _mm256_or_si256(a, b); }
+    static reg bit_xor(reg a, reg b) { return _mm256_xor_si256(a, b); }
+    static reg bit_not(reg a) { return _mm256_xor_si256(a, _mm256_set1_epi32(-1)); }
+
+    static mask eq(reg a, reg b) { return _mm256_cmpeq_epi32(a, b); }
+    static mask ne(reg a, reg b) { return bit_not(eq(a, b)); }
+    static mask lt(reg a, reg b) { return _mm256_cmpgt_epi32(b, a); }
+    static mask le(reg a, reg b) { return bit_not(_mm256_cmpgt_epi32(a, b)); }
+
+    static reg select(mask m, reg a, reg b) { return _mm256_blendv_epi8(b, a, m); }
+
+    static mask mask_and(mask a, mask b) { return _mm256_and_si256(a, b); }
+    static mask mask_or(mask a, mask b) { return _mm256_or_si256(a, b); }
+    static mask mask_xor(mask a, mask b) { return _mm256_xor_si256(a, b); }
+    static mask mask_not(mask a) { return bit_not(a); }
+    static mask mask_broadcast(bool b) { return _mm256_set1_epi32(-int(b)); }
+    static std::uint64_t mask_bits(mask m) { return unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(m))); }
+  };
+#endif	// __AVX2__
+
+#if defined(__AVX512F__)
+// AVX-512F: 16 floats, 8 doubles, 16 int32s. Masks are k-registers.
+
+// min and max use the zero-masking forms with every lane enabled, which compile to the same
+// instruction; the plain forms warn of an uninitialized value inside GCC's intrinsics header.
+
+template<>
+  struct simd_abi<float, 16> {
+    using reg = __m512;
+    using mask = __mmask16;
+
+    static reg load(const float* p) { return _mm512_loadu_ps(p); }
+    static void store(reg a, float* p) { _mm512_storeu_ps(p, a); }
+    static reg broadcast(float x) { return _mm512_set1_ps(x); }
+
+    static reg add(reg a, reg b) { return _mm512_add_ps(a, b); }
+    static reg sub(reg a, reg b) { return _mm512_sub_ps(a, b); }
+    static reg mul(reg a, reg b) { return _mm512_mul_ps(a, b); }
+    static reg div(reg a, reg b) { return _mm512_div_ps(a, b); }
+    // The float xor is AVX512DQ, so the sign is flipped in the integer domain.
+    static reg neg(reg a) { return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(a), _mm512_set1_epi32(INT32_MIN))); }
+    static reg min(reg a, reg b) { return _mm512_maskz_min_ps(0xffff, b, a); }
+    static reg max(reg a, reg b) { return _mm512_maskz_max_ps(0xffff, b, a); }
+
+    static mask eq(reg a, reg b) { return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+    static mask ne(reg a, reg b) { return _mm512_cmp_ps_mask(a, b, _CMP_NEQ_UQ); }
+    static mask lt(reg a, reg b) { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+    static mask le(reg a, reg b) { return _mm512_cmp_ps_mask(a, b, _CMP_LE_OQ); }
+
+    static reg select(mask m, reg a, reg b) { return _mm512_mask_blend_ps(m, b, a); }
+
+    static mask mask_and(mask a, mask b) { return mask(a & b); }
+    static mask mask_or(mask a, mask b) { return mask(a | b); }
+    static mask mask_xor(mask a, mask b) { return mask(a ^ b); }
+    static mask mask_not(mask a) { return mask(~a); }
+    static mask mask_broadcast(bool b) { return b ? mask(0xffff) : mask(0); }
+    static std::uint64_t mask_bits(mask m) { return m; }
+  };
+
+template<>
+  struct simd_abi<double, 8> {
+    using reg = __m512d;
+    using mask = __mmask8;
+
+    static reg load(const double* p) { return _mm512_loadu_pd(p); }
+    static void store(reg a, double* p) { _mm512_storeu_pd(p, a); }
+    static reg broadcast(double x) { return _mm512_set1_pd(x); }
+
+    static reg add(reg a, reg b) { return _mm512_add_pd(a, b); }
+    static reg sub(reg a, reg b) { return _mm512_sub_pd(a, b); }
+    static reg mul(reg a, reg b) { return _mm512_mul_pd(a, b); }
+    static reg div(reg a, reg b) { return _mm512_div_pd(a, b); }
+    static reg neg(reg a) { return _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(a), _mm512_set1_epi64(INT64_MIN))); }
+    static reg min(reg a, reg b) { return _mm512_maskz_min_pd(0xff, b, a); }
+    static reg max(reg a, reg b) { return _mm512_maskz_max_pd(0xff, b, a); }
+
+    static mask eq(reg a, reg b) { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+    static mask ne(reg a, reg b) { return _mm512_cmp_pd_mask(a, b, _CMP_NEQ_UQ); }
+    static mask lt(reg a, reg b) { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+    static mask le(reg a, reg b) { return _mm512_cmp_pd_mask(a, b, _CMP_LE_OQ); }
+
+    static reg select(mask m, reg a, reg b) { return _mm512_mask_blend_pd(m, b, a); }
+
+    static mask mask_and(mask a, mask b) { return mask(a & b); }
+    static mask mask_or(mask a, mask b) { return mask(a | b); }
+    static mask mask_xor(mask a, mask b) { return mask(a ^ b); }
+    static mask mask_not(mask a) { return mask(~a); }
+    static mask mask_broadcast(bool b) { return b ? mask(0xff) : mask(0); }
+    static std::uint64_t mask_bits(mask m) { return m; }
+  };
+
+template<>
+  struct simd_abi<std::int32_t, 16> {
+    using reg = __m512i;
+    using mask = __mmask16;
+
+    static reg load(const std::int32_t* p) { return _mm512_loadu_si512(p); }
+    static void store(reg a, std::int32_t* p) { _mm512_storeu_si512(p, a); }
+    static reg broadcast(std::int32_t x) { return _mm512_set1_epi32(x); }
+
+    static reg add(reg a, reg b) { return _mm512_add_epi32(a, b); }
+    static reg sub(reg a, reg b) { return _mm512_sub_epi32(a, b); }
+    static reg mul(reg a, reg b) { return _mm512_mullo_epi32(a, b); }
+    static reg div(reg a, reg b) { return divide_lanes<std::int32_t, 16, simd_abi>(a, b); }
+    static reg neg(reg a) { return _mm512_sub_epi32(_mm512_setzero_si512(), a); }
+    static reg min(reg a, reg b) { return _mm512_maskz_min_epi32(0xffff, a, b); }
+    static reg max(reg a, reg b) { return _mm512_maskz_max_epi32(0xffff, a, b); }
+
+    static reg bit_and(reg a, reg b) { return _mm512_and_si512(a, b); }
+    static reg bit_or(reg a, reg b) { return _mm512_or_si512(a, b); }
+    static reg bit_xor(reg a, reg b) { return _mm512_xor_si512(a, b); }
+    static reg bit_not(reg a) { return _mm512_xor_si512(a, _mm512_set1_epi32(-1)); }
+
+    static mask eq(reg a, reg b) { return _mm512_cmpeq_epi32_mask(a, b); }
+    static mask ne(reg a, reg b) { return _mm512_cmpneq_epi32_mask(a, b); }
+    static mask lt(reg a, reg b) { return _mm512_cmplt_epi32_mask(a, b); }
+    static mask le(reg a, reg b) { return _mm512_cmple_epi32_mask(a, b); }
+
+    static reg select(mask m, reg a, reg b) { return _mm512_mask_blend_epi32(m, b, a); }
+
+    static mask mask_and(mask a, mask b) { return mask(a & b); }
+    static mask mask_or(mask a, mask b) { return mask(a | b); }
+    static mask mask_xor(mask a, mask b) { return mask(a ^ b); }
+    static mask mask_not(mask a) { return mask(~a); }
+    static mask mask_broadcast(bool b) { return b ? mask(0xffff) : mask(0); }
+    static std::uint64_t mask_bits(mask m) { return m; }
+  };
+#endif	// __AVX512F__
+
+}	// namespace impl
@@ -0,0 +1,268 @@
+#ifndef ALGORITHM_H
+#error This file cannot be included directly. Include algorithm.h
+#endif	// ALGORITHM_H
+
+// Implementations of the non-modifying and filling algorithms over an iterator and a sentinel.
+//
+// Each algorithm has two overloads. When the sentinel is the iterator type, the standard
+// algorithm is called, since the library specializes it for its own iterators: std::copy and
+// std::fill become memmove and memset on trivial types, and std::find is unrolled. Segmented
+// iterators call it once per segment (see segmented.h). Otherwise the sequence is walked
+// once, testing for the end as it goes. Partial ordering picks the first overload whenever
+// both apply.
+
+namespace impl {
+
+// for_each
+
+template<typename I, typename F>
+  F for_each(I first, I last, F f)
+  {
+    return for_each_bounded(first, last, std::move(f), boolean_constant<Segmented_iterator<I>()>{});
+  }
+
+template<typename I, typename S, typename F>
+  F for_each(I first, S last, F f)
+  {
+    for (; first != last; ++first)
+      f(*first);
+    return f;
+  }
+
+// find
+
+template<typename I, typename T>
+  I find(I first, I last, const T& value)
+  {
+    return find_bounded(first, last, value, boolean_constant<Segmented_iterator<I>()>{});
+  }
+
+template<typename I, typename S, typename T>
+  I find(I first, S last, const T& value)
+  {
+    while (first != last && !(*first == value))
+      ++first;
+    return first;
+  }
+
+template<typename I, typename P>
+  I find_if(I first, I last, P pred)
+  {
+    return std::find_if(first, last, pred);
+  }
+
+template<typename I, typename S, typename P>
+  I find_if(I first, S last, P pred)
+  {
+    while (first != last && !pred(*first))
+      ++first;
+    return first;
+  }
+
+// count
+
+template<typename I, typename T>
+  Difference_type<I> count(I first, I last, const T& value)
+  {
+    return std::count(first, last, value);
+  }
+
+template<typename I, typename S, typename T>
+  Difference_type<I> count(I first, S last, const T& value)
+  {
+    Difference_type<I> n = 0;
+    for (; first != last; ++first)
+      if (*first == value)
+        ++n;
+    return n;
+  }
+
+template<typename I, typename P>
+  Difference_type<I> count_if(I first, I last, P pred)
+  {
+    return std::count_if(first, last, pred);
+  }
+
+template<typename I, typename S, typename P>
+  Difference_type<I> count_if(I first, S last, P pred)
+  {
+    Difference_type<I> n = 0;
+    for (; first != last; ++first)
+      if (pred(*first))
+        ++n;
+    return n;
+  }
+
+// copy
+
+template<typename I, typename O>
+  O copy(I first, I last, O out)
+  {
+    return copy_bounded(first, last, out, boolean_constant<Segmented_iterator<I>()>{});
+  }
+
+template<typename I, typename S, typename O>
+  O copy(I first, S last, O out)
+  {
+    for (; first != last; ++first, ++out)
+      *out = *first;
+    return out;
+  }
+
+// fill
+
+template<typename I, typename T>
+  I fill(I first, I last, const T& value)
+  {
+    fill_bounded(first, last, value, boolean_constant<Segmented_iterator<I>()>{});
+    return last;
+  }
+
+template<typename I, typename S, typename T>
+  I fill(I first, S last, const T& value)
+  {
+    for (; first != last; ++first)
+      *first = value;
+    return first;
+  }
+
+// mismatch
+// With one sentinel, the second sequence must be at least as long as the first.
+// Arrays of Bitwise_comparable values are compared as bytes (see bitwise.h).
+
+template<typename I1, typename I2>
+  std::pair<I1, I2> mismatch(I1 first1, I1 last1, I2 first2)
+  {
+    return mismatch_iterators(first1, last1, first2, boolean_constant<Bitwise_iterators<I1, I2>()>{});
+  }
+
+template<typename I1, typename S1, typename I2>
+  std::pair<I1, I2> mismatch(I1 first1, S1 last1, I2 first2)
+  {
+    while (first1 != last1 && *first1 == *first2) {
+      ++first1;
+      ++first2;
+    }
+    return {first1, first2};
+  }
+
+// Two arrays are compared up to the end of the shorter one.
+template<typename I1, typename I2>
+  std::pair<I1, I2> mismatch_bounded(I1 first1, I1 last1, I2 first2, I2 last2, boolean_constant<true>)
+  {
+    if (last2 - first2 < last1 - first1)
+      last1 = first1 + (last2 - first2);
+    return mismatch_bytes(first1, last1, first2);
+  }
+
+template<typename I1, typename I2>
+  std::pair<I1, I2> mismatch_bounded(I1 first1, I1 last1, I2 first2, I2 last2, boolean_constant<false>)
+  {
+    while (first1 != last1 && first2 != last2 && *first1 == *first2) {
+      ++first1;
+      ++first2;
+    }
+    return {first1, first2};
+  }
+
+template<typename I1, typename I2>
+  std::pair<I1, I2> mismatch(I1 first1, I1 last1, I2 first2, I2 last2)
+  {
+    return mismatch_bounded(first1, last1, first2, last2, boolean_constant<Bitwise_iterators<I1, I2>()>{});
+  }
+
+template<typename I1, typename S1, typename I2, typename S2>
+  std::pair<I1, I2> mismatch(I1 first1, S1 last1, I2 first2, S2 last2)
+  {
+    while (first1 != last1 && first2 != last2 && *first1 == *first2) {
+      ++first1;
+      ++first2;
+    }
+    return {first1, first2};
+  }
+
+// equal
+
+template<typename I1, typename I2>
+  bool equal(I1 first1, I1 last1, I2 first2)
+  {
+    return equal_iterators(first1, last1, first2, boolean_constant<Bitwise_iterators<I1, I2>()>{});
+  }
+
+template<typename I1, typename S1, typename I2>
+  bool equal(I1 first1, S1 last1, I2 first2)
+  {
+    for (; first1 != last1; ++first1, ++first2)
+      if (!(*first1 == *first2))
+        return false;
+    return true;
+  }
+
+// Sequences of known length can be compared by length first, and then with the
+// 3-argument equal, which compares Bitwise_comparable arrays with memcmp.
+template<typename I1, typename I2>
+  bool equal_bounded(I1 first1, I1 last1, I2 first2, I2 last2, boolean_constant<true>)
+  {
+    return last1 - first1 == last2 - first2
+        && impl::equal(first1, last1, first2);
+  }
+
+template<typename I1, typename I2>
+  bool equal_bounded(I1 first1, I1 last1, I2 first2, I2 last2, boolean_constant<false>)
+  {
+    std::pair<I1, I2> p = impl::mismatch(first1, last1, first2, last2);
+    return p.first == last1 && p.second == last2;
+  }
+
+template<typename I1, typename I2>
+  bool equal(I1 first1, I1 last1, I2 first2, I2 last2)
+  {
+    return equal_bounded(first1, last1, first2, last2,
+                         boolean_constant<Random_access_iterator<I1>() && Random_access_iterator<I2>()>{});
+  }
+
+template<typename I1, typename S1, typename I2, typename S2>
+  bool equal(I1 first1, S1 last1, I2 first2, S2 last2)
+  {
+    std::pair<I1, I2> p = impl::mismatch(first1, last1, first2, last2);
+    return p.first == last1 && p.second == last2;
+  }
+
+// equal and mismatch for ranges. Bitwise_comparable contiguous ranges go to bitwise.h.
+
+template<typename R1, typename R2>
+  bool equal_ranges(const R1& r1, const R2& r2, boolean_constant<true>)
+  {
+    const auto* p = contiguous_data(r1);
+    std::size_t n = contiguous_size(r1);
+    return n == contiguous_size(r2) && equal_bytes(p, p + n, contiguous_data(r2));
+  }
+
+template<typename R1, typename R2>
+  bool equal_ranges(const R1& r1, const R2& r2, boolean_constant<false>)
+  {
+    using std::begin;
+    using std::end;
+    return impl::equal(begin(r1), end(r1), begin(r2), end(r2));
+  }
+
+template<typename R1, typename R2>
+  std::pair<Iterator_of<R1>, Iterator_of<R2>> mismatch_ranges(R1&& r1, R2&& r2, boolean_constant<true>)
+  {
+    using std::begin;
+    const auto* p = contiguous_data(r1);
+    const auto* q = contiguous_data(r2);
+    std::size_t n = std::min(contiguous_size(r1), contiguous_size(r2));
+    std::size_t i = mismatch_bytes(p, p + n, q).first - p;
+    return {begin(r1) + i, begin(r2) + i};
+  }
+
+template<typename R1, typename R2>
+  std::pair<Iterator_of<R1>, Iterator_of<R2>> mismatch_ranges(R1&& r1, R2&& r2, boolean_constant<false>)
+  {
+    using std::begin;
+    using std::end;
+    return impl::mismatch(begin(r1), end(r1), begin(r2), end(r2));
+  }
+
+}	// namespace impl
@@ -1,6 +1,6 @@
-#ifndef TRAITS_H
-#error This file cannot be included directly. Include traits.h
-#endif	// TRAITS_H
+#ifndef STREAMING_H
+#error This file cannot be included directly. Include streaming.h
+#endif	// STREAMING_H
 
 // These type functions work in the same way as the ones in operators.h
 // Note that in the specializations of is_output_streamable and is_input_streamable
@@ -0,0 +1,127 @@
+#ifndef ALGORITHM_H
+#error This file cannot be included directly. Include algorithm.h
+#endif	// ALGORITHM_H
+
+// Three-way quicksort.
+//
+// Each partitioning step compares every element with the pivot once, with compare_3way, and
+// splits the range into the elements less than, equivalent to and greater than the pivot.
+// Only the first and last parts are sorted further, so a run of equal keys is finished with
+// after one step instead of being compared again at every level. For strings this is one
+// compare() per element per level, where std::sort's < is one call per comparison but makes
+// more comparisons on inputs with many duplicates.
+//
+// Like introsort, it falls back to heapsort when the recursion gets too deep, and finishes
+// short ranges with insertion sort.
+
+namespace impl {
+
+// Below this many elements, insertion sort finishes the range.
+constexpr std::ptrdiff_t three_way_insertion_threshold = 16;
+
+// Compares values by their keys with compare_3way.
+template<typename K>
+  struct key_compare_3way {
+    K key;
+
+    template<typename T>
+      int operator()(const T& a, const T& b) const { return compare_3way(key(a), key(b)); }
+  };
+
+template<typename I, typename C>
+  void insertion_sort_3way(I first, I last, C& comp)
+  {
+    if (first == last)
+      return;
+    for (I i = first + 1; i != last; ++i) {
+      if (comp(*i, *(i - 1)) >= 0)
+        continue;
+      Value_type<I> x = std::move(*i);
+      I j = i;
+      do {
+        *j = std::move(*(j - 1));
+        --j;
+      } while (j != first && comp(x, *(j - 1)) < 0);
+      *j = std::move(x);
+    }
+  }
+
+// Move the median of *a, *b and *c to *a.
+template<typename I, typename C>
+  void median_to_first(I a, I b, I c, C& comp)
+  {
+    int ab = comp(*a, *b);
+    int bc = comp(*b, *c);
+    if ((ab < 0) == (bc < 0) && ab != 0 && bc != 0) {
+      std::iter_swap(a, b);				// b is between a and c.
+      return;
+    }
+    int ac = comp(*a, *c);
+    if ((ab < 0) != (ac < 0) || ab == 0 || ac == 0)
+      return;						// a is between b and c.
+    std::iter_swap(a, c);
+  }
+
+template<typename I, typename C>
+  void three_way_quicksort(I first, I last, C& comp, std::size_t depth)
+  {
+    while (last - first > three_way_insertion_threshold) {
+      if (depth == 0) {
+        auto less = [&comp](const Value_type<I>& a, const Value_type<I>& b) { return comp(a, b) < 0; };
+        std::make_heap(first, last, less);
+        std::sort_heap(first, last, less);
+        return;
+      }
+      --depth;
+
+      median_to_first(first, first + (last - first) / 2, last - 1, comp);
+
+      // The pivot stays at *first. Then [first + 1, lt) is less than it, [lt, i) is
+      // equivalent, and [gt, last) is greater.
+      I lt = first + 1;
+      I i = first + 1;
+      I gt = last;
+      while (i != gt) {
+        int c = comp(*i, *first);
+        if (c < 0)
+          std::iter_swap(lt++, i++);
+        else if (c > 0)
+          std::iter_swap(i, --gt);
+        else
+          ++i;
+      }
+      --lt;
+      std::iter_swap(first, lt);
+
+      // Recurse into the smaller part and loop on the larger, so the stack stays logarithmic.
+      if (lt - first < last - gt) {
+        three_way_quicksort(first, lt, comp, depth);
+        first = gt;
+      } else {
+        three_way_quicksort(gt, last, comp, depth);
+        last = lt;
+      }
+    }
+    insertion_sort_3way(first, last, comp);
+  }
+
+template<typename I, typename K>
+  void three_way_sort(I first, I last, K key)
+  {
+    key_compare_3way<K> comp{key};
+    std::size_t depth = 0;
+    for (auto n = last - first; n > 1; n /= 2)
+      depth += 2;
+    three_way_quicksort(first, last, comp, depth);
+  }
+
+// Is three-way quicksort better than std::sort for these keys? It is when compare_3way makes
+// a single call for them. Arithmetic keys are as cheap to compare twice as once.
+template<typename I, typename K>
+  constexpr bool Three_way_sortable()
+  {
+    using Key = Decay<Result_of<K(const Value_type<I>&)>>;
+    return !Arithmetic<Key>() && One_call_comparable<Key>();
+  }
+
+}	// namespace impl
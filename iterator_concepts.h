@@ -0,0 +1,304 @@
+#ifndef ITERATOR_CONCEPTS_H
+#define ITERATOR_CONCEPTS_H
+
+#include "comparison.h"
+#include "container_traits.h"
+#include <iterator>
+
+// The iterator concepts, from Readable to Random_access_iterator, segmented iterators,
+// sentinels, and the range concepts.
+
+namespace Estd {
+
+// An iterator whose sequence is stored in contiguous pieces, like std::deque's, is segmented.
+// A user makes an iterator segmented by specializing segmented_iterator_traits, which then
+// provides:
+//   segment_iterator         - iterates over the segments
+//   local_iterator           - iterates within one segment
+//   segment(i), local(i)     - the segment holding i, and i's position in it
+//   begin(s), end(s)         - the local range of the segment s
+//   compose(s, l)            - the iterator at position l of segment s
+template<typename I>
+  struct segmented_iterator_traits { };
+
+#include "impl/iterator.h"
+
+template<typename I>
+  using Iterator_category = typename impl::iterator_category_traits<I>::type;
+
+template<typename I>
+  constexpr bool Has_iterator_category()
+  {
+    return Substitution_succeeded<Iterator_category<I>>();
+  }
+
+// Dereferencing must give something that can be read as a value. Either it converts to
+// const Value_type<I>&, or I's associated reference type - which may be a proxy, such as
+// a reference to one bit - shares a common reference with Value_type<I>&.
+// Iterators customize their reference type with a member reference typedef or an overload
+// of deduce_reference (see impl/deduced_types.h), and proxies name the common reference
+// with basic_common_reference.
+template<typename I>
+  constexpr bool Readable()
+  {
+    using Ref = Require_lvalue_reference<Add_const<Value_type<I>>>;
+
+    return Has_value_type<I>()
+        && Has_dereference<I>()
+	&& (Convertible<Dereference_result<I>, Ref>()
+	 || (Has_reference<I>()
+	  && Common_reference_with<Add_rvalue_reference<Reference_of<I>>, Add_lvalue_reference<Value_type<I>>>()));
+  }
+
+template<typename I, typename T>
+  constexpr bool Writable()
+  {
+    return Assignable<Dereference_result<I>, T>();
+  }
+
+template<typename I>
+  constexpr bool Incrementable()
+  {
+    return Regular<I>()
+           
+        // Difference_type<I> must be signed.
+	&& Has_difference_type<I>()
+	&& Signed<Difference_type<I>>()
+
+	// ++i must return I&
+	&& Has_pre_increment<I>()
+	&& Same<Pre_increment_result<I>, I&>()
+
+	// i++ must return I
+	&& Has_post_increment<I>()
+	&& Same<Post_increment_result<I>, I>();
+  }
+
+template<typename I>
+ constexpr bool Decrementable()
+ {
+   return Incrementable<I>()
+
+       // --i must return I&
+       && Has_pre_decrement<I>()
+       && Same<Pre_decrement_result<I>, I&>()
+
+       // i-- must return I
+       && Has_post_decrement<I>()
+       && Same<Post_decrement_result<I>, I>();
+ }
+
+template<typename I, typename T>
+  constexpr bool Iterator_kind()
+  {
+    return Has_iterator_category<I>()
+        && Derived<Iterator_category<I>, T>();
+  }
+
+template<typename I>
+  constexpr bool Input_iterator()
+  {
+    return Readable<I>()
+        && Incrementable<I>()
+	&& Iterator_kind<I, std::input_iterator_tag>();
+  }
+
+template<typename I, typename T>
+  constexpr bool Output_iterator()
+  {
+    return Writable<I>()
+	
+	// We only care that these operators are present.
+	// We don't care about the type they yield, because often the operations are meaningless.
+        && Has_pre_increment<I>()
+	&& Has_post_increment<I>()
+
+	// But we do care if I really is an output iterator.
+	&& Iterator_kind<I, std::output_iterator_tag>();
+  }
+
+template<typename I>
+  constexpr bool Forward_iterator()
+  {
+    return Readable<I>()
+        && Incrementable<I>()
+	&& Iterator_kind<I, std::forward_iterator_tag>();
+  }
+
+template<typename I>
+  constexpr bool Bidirectional_iterator()
+  {
+    return Readable<I>()
+        && Decrementable<I>()
+	&& Iterator_kind<I, std::bidirectional_iterator_tag>();
+  }
+
+template<typename I>
+  constexpr bool Random_access_iterator()
+  {
+    using N = Difference_type<I>;
+
+    return Readable<I>()
+        && Decrementable<I>()
+
+	// i[n] must return I's associated reference type.
+	&& Has_subscript<I, N>()
+	&& Same<Subscript_result<I, N>, Reference_of<I>>()
+
+	// i += n must return I&.
+	&& Has_plus_assign<I, N>()
+	&& Same<Plus_assign_result<I, N>, I&>()
+
+	// i -= n must return I&.
+	&& Has_minus_assign<I, N>()
+	&& Same<Minus_assign_result<I, N>, I&>()
+
+	// i + n must return I.
+	&& Has_plus<I, N>()
+	&& Same<Plus_result<I, N>, I>()
+
+	// n + i must return I.
+	&& Has_plus<N, I>()
+	&& Same<Plus_result<N, I>, I>()
+
+	// i - n must return I.
+	&& Has_minus<I, N>()
+	&& Same<Minus_result<I, N>, I>()
+
+	// i - j must return N.
+	&& Has_minus<I>()
+	&& Same<Minus_result<I>, N>()
+
+	&& Iterator_kind<I, std::random_access_iterator_tag>();
+  }
+
+// Segmented iterators - after Austern, "Segmented Iterators and Hierarchical Algorithms".
+// An algorithm over a segmented sequence can run a loop over the local iterators of each
+// segment, which don't test for the end of the segment on every increment.
+template<typename I>
+  using Segment_iterator = typename impl::get_segment_iterator<I>::type;
+
+template<typename I>
+  using Local_iterator = typename impl::get_local_iterator<I>::type;
+
+template<typename I>
+  constexpr bool Segmented_iterator()
+  {
+    return Forward_iterator<I>()
+        && Substitution_succeeded<Segment_iterator<I>>()
+	&& Substitution_succeeded<Local_iterator<I>>()
+	&& Regular<Segment_iterator<I>>()
+	&& Has_pre_increment<Segment_iterator<I>>()
+	&& Forward_iterator<Local_iterator<I>>()
+	&& Same<Value_type<Local_iterator<I>>, Value_type<I>>();
+  }
+
+template<typename T>
+  using Begin_result = typename impl::get_begin_result<T>::type;
+
+template<typename T>
+  constexpr bool Has_begin()
+  {
+    return Substitution_succeeded<Begin_result<T>>();
+  }
+
+template<typename T>
+  using End_result = typename impl::get_end_result<T>::type;
+
+template<typename T>
+  constexpr bool Has_end()
+  {
+    return Substitution_succeeded<End_result<T>>();
+  }
+
+template<typename T>
+  using Iterator_of = Begin_result<T>;
+
+template<typename T>
+  constexpr bool Iterator()
+  {
+    return Incrementable<T>()
+        && Has_dereference<T>()
+	&& Has_iterator_category<T>();
+  }
+
+// A sentinel marks the end of a sequence without being an iterator into it, e.g. the null
+// terminator of a C string. It only has to compare with the iterator. Every iterator is
+// a sentinel for itself.
+//
+// Unlike Equality_comparable<I, S>(), this does not require a common type: a sentinel
+// is not a value of the iterator type.
+template<typename S, typename I>
+  constexpr bool Sentinel_for()
+  {
+    return Semiregular<S>()
+        && Iterator<I>()
+	&& Has_equal<I, S>()     && Boolean<Equal_result<I, S>>()
+	&& Has_equal<S, I>()     && Boolean<Equal_result<S, I>>()
+	&& Has_not_equal<I, S>() && Boolean<Not_equal_result<I, S>>()
+	&& Has_not_equal<S, I>() && Boolean<Not_equal_result<S, I>>();
+  }
+
+template<typename T>
+  using Sentinel_of = End_result<T>;
+
+// A range is an iterator and a sentinel. The end need not have the type of the beginning,
+// so a delimited sequence can be traversed in one pass, without first finding its end.
+template<typename T>
+  constexpr bool Range()
+  {
+    return Has_begin<T>()
+        && Has_end<T>()
+	&& Iterator<Iterator_of<T>>()
+	&& Sentinel_for<Sentinel_of<T>, Iterator_of<T>>();
+  }
+
+// A range whose end is an iterator, as the containers and the algorithms of the
+// standard library require.
+template<typename T>
+  constexpr bool Bounded_range()
+  {
+    return Range<T>()
+        && Same<Iterator_of<T>, Sentinel_of<T>>();
+  }
+
+// C++11 has no way to ask whether the elements of a range are adjacent in memory.
+// We accept built-in arrays, and ranges whose data() member yields a pointer and
+// which have a size(), such as std::vector, std::array and std::string.
+template<typename T>
+  constexpr bool Contiguous_range()
+  {
+    return Array<Remove_reference<T>>()
+        || (Range<T>()
+         && Has_member_data<T>()
+         && Pointer<Member_data<T>>()
+         && Has_member_size<T>());
+  }
+
+namespace impl {
+
+// Access to the elements of a Contiguous_range.
+
+template<typename T, std::size_t N>
+  const T* contiguous_data(const T (&a)[N]) { return a; }
+
+template<typename T, std::size_t N>
+  T* contiguous_data(T (&a)[N]) { return a; }
+
+template<typename R>
+  auto contiguous_data(const R& r) -> decltype(r.data()) { return r.data(); }
+
+template<typename R>
+  auto contiguous_data(R& r) -> decltype(r.data()) { return r.data(); }
+
+template<typename T, std::size_t N>
+  std::size_t contiguous_size(const T (&)[N]) { return N; }
+
+template<typename R>
+  std::size_t contiguous_size(const R& r) { return r.size(); }
+
+}	// namespace impl
+
+}	// namespace Estd
+
+#endif	// ITERATOR_CONCEPTS_H
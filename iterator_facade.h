@@ -0,0 +1,190 @@
+#ifndef ITERATOR_FACADE_H
+#define ITERATOR_FACADE_H
+
+#include "constraints.h"
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+// iterator_facade generates the operators of an iterator from a few primitive operations,
+// after the facade in Origin (and Boost before it).
+//
+// The derived iterator D provides:
+//   dereference() const     - the result of *i
+//   equal(const D&) const   - i == j
+//   increment()             - ++i
+//   decrement()             - --i, for bidirectional and random access iterators
+//   advance(n)              - i += n, for random access iterators
+//   distance_to(const D& j) const - j - i, for random access iterators
+//
+// An operator is only declared when the iterator category calls for it, so the operator
+// detectors in traits.h report exactly what the category promises. D can keep its primitive
+// operations private by befriending its iterator_facade base.
+
+namespace Estd {
+
+namespace impl {
+
+// The result of operator-> when dereferencing yields a value rather than an lvalue:
+// the value is kept alive in the proxy for the duration of the member access.
+template<typename Reference>
+  struct arrow_proxy {
+    Reference r;
+
+    Add_pointer<Remove_reference<Reference>> operator->() { return &r; }
+  };
+
+}	// namespace impl
+
+template<typename D,
+         typename Value,
+         typename Reference,
+         typename Category,
+         typename Difference = std::ptrdiff_t>
+  class iterator_facade {
+  public:
+    using value_type = Value;
+    using reference = Reference;
+    using pointer = Conditional<Lvalue_reference<Reference>(),
+                                Add_pointer<Remove_reference<Reference>>,
+                                impl::arrow_proxy<Reference>>;
+    using difference_type = Difference;
+    using iterator_category = Category;
+
+    reference operator*() const
+    {
+      return self().dereference();
+    }
+
+    pointer operator->() const
+    {
+      return arrow(boolean_constant<Lvalue_reference<Reference>()>{});
+    }
+
+    D& operator++()
+    {
+      self().increment();
+      return self();
+    }
+
+    D operator++(int)
+    {
+      D tmp(self());
+      self().increment();
+      return tmp;
+    }
+
+    friend bool operator==(const D& a, const D& b) { return equal(a, b); }
+
+    friend bool operator!=(const D& a, const D& b) { return !equal(a, b); }
+
+    // Bidirectional operations.
+
+    template<typename C = Category,
+             typename = Enable_if<Derived<C, std::bidirectional_iterator_tag>()>>
+      D& operator--()
+      {
+        self().decrement();
+        return self();
+      }
+
+    template<typename C = Category,
+             typename = Enable_if<Derived<C, std::bidirectional_iterator_tag>()>>
+      D operator--(int)
+      {
+        D tmp(self());
+        self().decrement();
+        return tmp;
+      }
+
+    // Random access operations.
+
+    template<typename C = Category,
+             typename = Enable_if<Derived<C, std::random_access_iterator_tag>()>>
+      D& operator+=(difference_type n)
+      {
+        self().advance(n);
+        return self();
+      }
+
+    template<typename C = Category,
+             typename = Enable_if<Derived<C, std::random_access_iterator_tag>()>>
+      D& operator-=(difference_type n)
+      {
+        self().advance(-n);
+        return self();
+      }
+
+    template<typename C = Category,
+             typename = Enable_if<Derived<C, std::random_access_iterator_tag>()>>
+      D operator+(difference_type n) const
+      {
+        D tmp(self());
+        tmp.advance(n);
+        return tmp;
+      }
+
+    template<typename C = Category,
+             typename = Enable_if<Derived<C, std::random_access_iterator_tag>()>>
+      friend D operator+(difference_type n, const D& i)
+      {
+        return i + n;
+      }
+
+    template<typename C = Category,
+             typename = Enable_if<Derived<C, std::random_access_iterator_tag>()>>
+      D operator-(difference_type n) const
+      {
+        D tmp(self());
+        tmp.advance(-n);
+        return tmp;
+      }
+
+    template<typename C = Category,
+             typename = Enable_if<Derived<C, std::random_access_iterator_tag>()>>
+      difference_type operator-(const D& j) const
+      {
+        return j.distance_to(self());
+      }
+
+    template<typename C = Category,
+             typename = Enable_if<Derived<C, std::random_access_iterator_tag>()>>
+      reference operator[](difference_type n) const
+      {
+        D tmp(self());
+        tmp.advance(n);
+        return tmp.dereference();
+      }
+
+    template<typename C = Category,
+             typename = Enable_if<Derived<C, std::random_access_iterator_tag>()>>
+      bool operator<(const D& j) const { return self().distance_to(j) > 0; }
+
+    template<typename C = Category,
+             typename = Enable_if<Derived<C, std::random_access_iterator_tag>()>>
+      bool operator>(const D& j) const { return self().distance_to(j) < 0; }
+
+    template<typename C = Category,
+             typename = Enable_if<Derived<C, std::random_access_iterator_tag>()>>
+      bool operator<=(const D& j) const { return self().distance_to(j) >= 0; }
+
+    template<typename C = Category,
+             typename = Enable_if<Derived<C, std::random_access_iterator_tag>()>>
+      bool operator>=(const D& j) const { return self().distance_to(j) <= 0; }
+
+  private:
+    D& self() { return static_cast<D&>(*this); }
+
+    const D& self() const { return static_cast<const D&>(*this); }
+
+    // The friend operators reach D's primitives through the facade, which D befriends.
+    static bool equal(const D& a, const D& b) { return a.equal(b); }
+
+    pointer arrow(boolean_constant<true>) const { return &self().dereference(); }
+
+    pointer arrow(boolean_constant<false>) const { return pointer{self().dereference()}; }
+  };
+
+}	// namespace Estd
+
+#endif	// ITERATOR_FACADE_H
@@ -0,0 +1,316 @@
+#ifndef MATRIX_H
+#define MATRIX_H
+
+#include "constraints.h"
+#include "platform.h"
+#include "simd.h"
+#include <cstddef>
+
+// vec<T, N> and mat<T, R, C> are small fixed-size vectors and row-major matrices, for the
+// 2x2 to 8x8 linear algebra of geometry and signal processing - compare Matrix, pg. 827.
+// At these sizes a loop costs as much as the arithmetic, so every operation is expanded
+// over the elements at compile time, from an index_sequence: vec<float, 4> + vec<float, 4>
+// is four additions in a row, which the compiler combines into vector instructions, and
+// nothing is ever on the heap. The operations are constexpr:
+//
+//   constexpr mat<int, 2, 2> m(vec<int, 2>(1, 2), vec<int, 2>(3, 4));
+//   static_assert(m * vec<int, 2>(1, 1) == vec<int, 2>(3, 7), "");
+//
+// Sums of products, as in dot and the matrix products, are added as a balanced tree, so an
+// 8-term dot product has a dependency chain of 3 additions instead of 7.
+//
+// A vec of 4 or 8 floats or doubles is aligned for a vector register, up to 16 bytes, in
+// every language version: operator new gives 16 bytes without C++17 aligned new, and the
+// layout of vec must not change with the -std of the translation unit. A wider vec is read
+// with unaligned loads, which cost next to nothing when they don't cross a cache line.
+//
+// transform_many multiplies every vec of a Contiguous_range by one matrix. When a column of
+// the matrix fits a vector register (see Native_simd in simd.h), it keeps the columns in
+// simd registers and forms each product as a sum of columns scaled by the elements of the
+// vec, C multiply-adds per vec; other sizes use the unrolled product.
+
+namespace Estd {
+
+template<typename T, std::size_t N>
+  class vec;
+
+template<typename T, std::size_t R, std::size_t C>
+  class mat;
+
+namespace impl {
+
+// The alignment of vec<T, N>: a vector register, up to 16 bytes, for 4 or 8 floating
+// point values.
+template<typename T, std::size_t N>
+  constexpr std::size_t vec_alignment()
+  {
+    return Floating_point<T>() && (N == 4 || N == 8) ? (N * sizeof(T) < 16 ? N * sizeof(T) : 16) : alignof(T);
+  }
+
+// The sum of a[i] * b[i] for i in [Lo, Hi), as a balanced tree.
+
+template<std::size_t Lo, std::size_t Hi, typename T, std::size_t N>
+  constexpr T dot_tree(const vec<T, N>& a, const vec<T, N>& b, boolean_constant<true>)
+  {
+    return a[Lo] * b[Lo];
+  }
+
+template<std::size_t Lo, std::size_t Hi, typename T, std::size_t N>
+  constexpr T dot_tree(const vec<T, N>& a, const vec<T, N>& b, boolean_constant<false>)
+  {
+    return dot_tree<Lo, (Lo + Hi) / 2>(a, b, boolean_constant<(Hi - Lo) / 2 == 1>{})
+         + dot_tree<(Lo + Hi) / 2, Hi>(a, b, boolean_constant<Hi - (Lo + Hi) / 2 == 1>{});
+  }
+
+}	// namespace impl
+
+template<typename T, std::size_t N>
+  class alignas(impl::vec_alignment<T, N>()) vec {
+    static_assert(Arithmetic<T>() && !Same<Remove_cv<T>, bool>(), "vec: requires an arithmetic element type");
+    static_assert(N != 0, "vec: requires at least one element");
+
+    using indices = make_index_sequence<N>;
+
+  public:
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = T*;
+    using const_iterator = const T*;
+    using size_type = std::size_t;
+
+    static constexpr std::size_t size() { return N; }
+
+    // Zero.
+    constexpr vec() : v() { }
+
+    // Every element is x.
+    explicit constexpr vec(T x) : vec(x, indices{}) { }
+
+    // The N elements.
+    template<typename... Us,
+             typename = Enable_if<sizeof...(Us) == N && (N > 1) && impl::all_of<Convertible<Us, T>()...>()>>
+      constexpr vec(const Us&... xs) : v{static_cast<T>(xs)...} { }
+
+    constexpr const T& operator[](std::size_t i) const { return v[i]; }
+    ESTD_CXX14_CONSTEXPR T& operator[](std::size_t i) { return v[i]; }
+
+    ESTD_CXX14_CONSTEXPR T* data() { return v; }
+    constexpr const T* data() const { return v; }
+
+    ESTD_CXX14_CONSTEXPR iterator begin() { return v; }
+    ESTD_CXX14_CONSTEXPR iterator end() { return v + N; }
+    constexpr const_iterator begin() const { return v; }
+    constexpr const_iterator end() const { return v + N; }
+
+    friend constexpr vec operator+(const vec& a, const vec& b) { return add(a, b, indices{}); }
+    friend constexpr vec operator-(const vec& a, const vec& b) { return sub(a, b, indices{}); }
+    friend constexpr vec operator-(const vec& a) { return neg(a, indices{}); }
+    friend constexpr vec operator*(const vec& a, T k) { return scale(a, k, indices{}); }
+    friend constexpr vec operator*(T k, const vec& a) { return scale(a, k, indices{}); }
+    friend constexpr vec operator/(const vec& a, T k) { return divide(a, k, indices{}); }
+
+    friend ESTD_CXX14_CONSTEXPR vec& operator+=(vec& a, const vec& b) { return a = a + b; }
+    friend ESTD_CXX14_CONSTEXPR vec& operator-=(vec& a, const vec& b) { return a = a - b; }
+    friend ESTD_CXX14_CONSTEXPR vec& operator*=(vec& a, T k) { return a = a * k; }
+    friend ESTD_CXX14_CONSTEXPR vec& operator/=(vec& a, T k) { return a = a / k; }
+
+    friend constexpr bool operator==(const vec& a, const vec& b) { return equal(a, b, indices{}); }
+    friend constexpr bool operator!=(const vec& a, const vec& b) { return !(a == b); }
+
+  private:
+    template<std::size_t... I>
+      constexpr vec(T x, index_sequence<I...>) : v{((void)I, x)...} { }
+
+    template<std::size_t... I>
+      static constexpr vec add(const vec& a, const vec& b, index_sequence<I...>) { return vec(a.v[I] + b.v[I]...); }
+
+    template<std::size_t... I>
+      static constexpr vec sub(const vec& a, const vec& b, index_sequence<I...>) { return vec(a.v[I] - b.v[I]...); }
+
+    template<std::size_t... I>
+      static constexpr vec neg(const vec& a, index_sequence<I...>) { return vec(-a.v[I]...); }
+
+    template<std::size_t... I>
+      static constexpr vec scale(const vec& a, T k, index_sequence<I...>) { return vec(a.v[I] * k...); }
+
+    template<std::size_t... I>
+      static constexpr vec divide(const vec& a, T k, index_sequence<I...>) { return vec(a.v[I] / k...); }
+
+    template<std::size_t... I>
+      static constexpr bool equal(const vec& a, const vec& b, index_sequence<I...>) { return impl::All(a.v[I] == b.v[I]...); }
+
+    T v[N];
+  };
+
+template<typename T, std::size_t N>
+  constexpr T dot(const vec<T, N>& a, const vec<T, N>& b)
+  {
+    return impl::dot_tree<0, N>(a, b, boolean_constant<N == 1>{});
+  }
+
+template<typename T>
+  constexpr vec<T, 3> cross(const vec<T, 3>& a, const vec<T, 3>& b)
+  {
+    return vec<T, 3>(a[1] * b[2] - a[2] * b[1],
+                     a[2] * b[0] - a[0] * b[2],
+                     a[0] * b[1] - a[1] * b[0]);
+  }
+
+template<typename T, std::size_t R, std::size_t C>
+  class mat {
+    static_assert(R != 0 && C != 0, "mat: requires at least one row and one column");
+
+    using row_indices = make_index_sequence<R>;
+    using column_indices = make_index_sequence<C>;
+
+  public:
+    using value_type = T;
+    using row_type = vec<T, C>;
+    using column_type = vec<T, R>;
+
+    static constexpr std::size_t rows() { return R; }
+    static constexpr std::size_t columns() { return C; }
+
+    // Zero.
+    constexpr mat() : r() { }
+
+    // The R rows.
+    template<typename... Rows,
+             typename = Enable_if<sizeof...(Rows) == R && impl::all_of<Same<Rows, row_type>()...>()>>
+      constexpr mat(const Rows&... rows) : r{rows...} { }
+
+    static constexpr mat identity() { return identity(row_indices{}); }
+
+    constexpr const row_type& operator[](std::size_t i) const { return r[i]; }
+    ESTD_CXX14_CONSTEXPR row_type& operator[](std::size_t i) { return r[i]; }
+
+    constexpr const row_type& row(std::size_t i) const { return r[i]; }
+    constexpr column_type column(std::size_t j) const { return column(j, row_indices{}); }
+
+    constexpr mat<T, C, R> transpose() const { return transpose(column_indices{}); }
+
+    friend constexpr mat operator+(const mat& a, const mat& b) { return add(a, b, row_indices{}); }
+    friend constexpr mat operator-(const mat& a, const mat& b) { return sub(a, b, row_indices{}); }
+    friend constexpr mat operator-(const mat& a) { return neg(a, row_indices{}); }
+    friend constexpr mat operator*(const mat& a, T k) { return scale(a, k, row_indices{}); }
+    friend constexpr mat operator*(T k, const mat& a) { return scale(a, k, row_indices{}); }
+    friend constexpr mat operator/(const mat& a, T k) { return divide(a, k, row_indices{}); }
+
+    friend ESTD_CXX14_CONSTEXPR mat& operator+=(mat& a, const mat& b) { return a = a + b; }
+    friend ESTD_CXX14_CONSTEXPR mat& operator-=(mat& a, const mat& b) { return a = a - b; }
+    friend ESTD_CXX14_CONSTEXPR mat& operator*=(mat& a, T k) { return a = a * k; }
+    friend ESTD_CXX14_CONSTEXPR mat& operator/=(mat& a, T k) { return a = a / k; }
+
+    // The product with a column vector.
+    friend constexpr column_type operator*(const mat& a, const row_type& x) { return apply(a, x, row_indices{}); }
+
+    // The product of an R x C and a C x K matrix. Each element is the dot product of a row
+    // of a and a row of the transpose of b.
+    template<std::size_t K>
+      friend constexpr mat<T, R, K> operator*(const mat& a, const mat<T, C, K>& b)
+      {
+        return multiply(a, b.transpose(), row_indices{});
+      }
+
+    friend constexpr bool operator==(const mat& a, const mat& b) { return equal(a, b, row_indices{}); }
+    friend constexpr bool operator!=(const mat& a, const mat& b) { return !(a == b); }
+
+  private:
+    template<std::size_t... J>
+      static constexpr row_type unit_row(std::size_t i, index_sequence<J...>) { return row_type((J == i ? T(1) : T(0))...); }
+
+    template<std::size_t... I>
+      static constexpr mat identity(index_sequence<I...>) { return mat(unit_row(I, column_indices{})...); }
+
+    template<std::size_t... I>
+      constexpr column_type column(std::size_t j, index_sequence<I...>) const { return column_type(r[I][j]...); }
+
+    template<std::size_t... J>
+      constexpr mat<T, C, R> transpose(index_sequence<J...>) const { return mat<T, C, R>(column(J)...); }
+
+    template<std::size_t... I>
+      static constexpr mat add(const mat& a, const mat& b, index_sequence<I...>) { return mat(a.r[I] + b.r[I]...); }
+
+    template<std::size_t... I>
+      static constexpr mat sub(const mat& a, const mat& b, index_sequence<I...>) { return mat(a.r[I] - b.r[I]...); }
+
+    template<std::size_t... I>
+      static constexpr mat neg(const mat& a, index_sequence<I...>) { return mat(-a.r[I]...); }
+
+    template<std::size_t... I>
+      static constexpr mat scale(const mat& a, T k, index_sequence<I...>) { return mat(a.r[I] * k...); }
+
+    template<std::size_t... I>
+      static constexpr mat divide(const mat& a, T k, index_sequence<I...>) { return mat(a.r[I] / k...); }
+
+    template<std::size_t... I>
+      static constexpr column_type apply(const mat& a, const row_type& x, index_sequence<I...>)
+      {
+        return column_type(dot(a.r[I], x)...);
+      }
+
+    template<std::size_t K, std::size_t... I>
+      static constexpr mat<T, R, K> multiply(const mat& a, const mat<T, K, C>& bt, index_sequence<I...>)
+      {
+        return mat<T, R, K>((bt * a.r[I])...);
+      }
+
+    template<std::size_t... I>
+      static constexpr bool equal(const mat& a, const mat& b, index_sequence<I...>) { return impl::All(a.r[I] == b.r[I]...); }
+
+    row_type r[R];
+  };
+
+// Batched products.
+
+namespace impl {
+
+// One unrolled product per vec.
+template<typename T, std::size_t R, std::size_t C>
+  void transform_many(const mat<T, R, C>& m, const vec<T, C>* in, vec<T, R>* out, std::size_t n,
+                      boolean_constant<false>)
+  {
+    for (std::size_t i = 0; i != n; ++i)
+      out[i] = m * in[i];
+  }
+
+// The columns of m in registers; each product is the sum of the columns, each scaled by
+// one element of the vec.
+template<typename T, std::size_t R, std::size_t C>
+  void transform_many(const mat<T, R, C>& m, const vec<T, C>* in, vec<T, R>* out, std::size_t n,
+                      boolean_constant<true>)
+  {
+    using V = simd<T, R>;
+
+    V cols[C];
+    for (std::size_t k = 0; k != C; ++k)
+      cols[k] = V::load(m.column(k).data());
+
+    for (std::size_t i = 0; i != n; ++i) {
+      const T* x = in[i].data();
+      V acc = cols[0] * x[0];
+      for (std::size_t k = 1; k != C; ++k)
+        acc += cols[k] * x[k];
+      acc.store(out[i].data());
+    }
+  }
+
+}	// namespace impl
+
+// out[i] = m * in[i] for every element of in. out must have at least as many elements, and
+// may be in itself when m is square.
+template<typename T, std::size_t R, std::size_t C, typename In, typename Out>
+  void transform_many(const mat<T, R, C>& m, const In& in, Out&& out)
+  {
+    static_assert(Contiguous_range<const In&>() && Contiguous_range<Out>(), "transform_many: requires contiguous ranges");
+    static_assert(Same<Remove_cv<Value_type<In>>, vec<T, C>>(), "transform_many: the input elements must be vec<T, C>");
+    static_assert(Same<Value_type<Remove_reference<Out>>, vec<T, R>>(), "transform_many: the output elements must be vec<T, R>");
+
+    impl::transform_many(m, impl::contiguous_data(in), impl::contiguous_data(out), impl::contiguous_size(in),
+                         boolean_constant<Native_simd<T, R>()>{});
+  }
+
+}	// namespace Estd
+
+#endif	// MATRIX_H
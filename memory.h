@@ -0,0 +1,85 @@
+#ifndef MEMORY_H
+#define MEMORY_H
+
+#include "platform.h"
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace Estd {
+
+// aligned_allocator is a standard allocator whose blocks start on an Align-byte boundary.
+// The containers use it to put their arrays on cache line boundaries, which matters for
+// prefetching and for aligned SIMD loads.
+//
+// C++11 has no aligned operator new, so we over-allocate and keep the address returned
+// by operator new in the word just before the aligned block.
+
+template<typename T, std::size_t Align = cache_line_size>
+  class aligned_allocator {
+    static_assert(Align != 0 && (Align & (Align - 1)) == 0,
+                  "aligned_allocator: Align must be a power of two");
+    static_assert(Align >= alignof(void*),
+                  "aligned_allocator: Align must be at least the alignment of a pointer");
+
+  public:
+    using value_type = T;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    // aligned_allocator has a non-type parameter, so std::allocator_traits can't rebind it for us.
+    template<typename U>
+      struct rebind {
+        using other = aligned_allocator<U, Align>;
+      };
+
+    static constexpr std::size_t alignment = Align;
+
+    aligned_allocator() noexcept { }
+
+    template<typename U>
+      aligned_allocator(const aligned_allocator<U, Align>&) noexcept { }
+
+    T* allocate(std::size_t n)
+    {
+      if (n > max_size())
+        throw std::bad_alloc();
+
+      void* raw = ::operator new(n * sizeof(T) + Align + sizeof(void*));
+      std::uintptr_t first = reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*);
+      std::uintptr_t aligned = (first + Align - 1) & ~std::uintptr_t(Align - 1);
+      reinterpret_cast<void**>(aligned)[-1] = raw;
+      return reinterpret_cast<T*>(aligned);
+    }
+
+    void deallocate(T* p, std::size_t) noexcept
+    {
+      if (p)
+        ::operator delete(reinterpret_cast<void**>(p)[-1]);
+    }
+
+    std::size_t max_size() const noexcept
+    {
+      return (std::size_t(-1) - Align - sizeof(void*)) / sizeof(T);
+    }
+  };
+
+template<typename T, typename U, std::size_t Align>
+  bool operator==(const aligned_allocator<T, Align>&, const aligned_allocator<U, Align>&)
+  {
+    return true;
+  }
+
+template<typename T, typename U, std::size_t Align>
+  bool operator!=(const aligned_allocator<T, Align>&, const aligned_allocator<U, Align>&)
+  {
+    return false;
+  }
+
+}	// namespace Estd
+
+#endif	// MEMORY_H
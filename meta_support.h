@@ -1,6 +1,8 @@
 #ifndef META_SUPPORT_H
 #define META_SUPPORT_H
 
+#include <cstddef>
+#include <cstdint>
 #include <type_traits>
 
 namespace Estd {
@@ -44,6 +46,295 @@ template<typename T>
     return substitution_succeeded<T>::value;
   }
 
+// Compile-time sequences of indices, as in C++14's <utility>, for expanding tuples
+// and parameter packs element by element.
+
+template<std::size_t... Ns>
+  struct index_sequence {
+    using type = index_sequence;
+
+    static constexpr std::size_t size() { return sizeof...(Ns); }
+  };
+
+namespace impl {
+
+template<typename S1, typename S2>
+  struct concat_index_sequence;
+
+template<std::size_t... N1, std::size_t... N2>
+  struct concat_index_sequence<index_sequence<N1...>, index_sequence<N2...>> {
+    using type = index_sequence<N1..., (sizeof...(N1) + N2)...>;
+  };
+
+// Build the sequence from two halves, so that the depth of instantiation is log N.
+template<std::size_t N>
+  struct make_index_sequence
+    : concat_index_sequence<typename make_index_sequence<N / 2>::type,
+                            typename make_index_sequence<N - N / 2>::type> { };
+
+template<>
+  struct make_index_sequence<0> {
+    using type = index_sequence<>;
+  };
+
+template<>
+  struct make_index_sequence<1> {
+    using type = index_sequence<0>;
+  };
+
+}	// namespace impl
+
+template<std::size_t N>
+  using make_index_sequence = typename impl::make_index_sequence<N>::type;
+
+template<typename... Ts>
+  using index_sequence_for = make_index_sequence<sizeof...(Ts)>;
+
+// The smallest unsigned type that holds every value from 0 to N, for the indexes of small
+// tables.
+template<std::size_t N>
+  using Smallest_unsigned =
+    typename std::conditional<N <= 0xff, std::uint8_t,
+      typename std::conditional<N <= 0xffff, std::uint16_t,
+        typename std::conditional<N <= 0xffffffff, std::uint32_t, std::uint64_t>::type>::type>::type;
+
+namespace impl {
+
+// True when every argument is. For constant arguments, all_of below avoids the recursion.
+constexpr bool All()
+{
+  return true;
+}
+
+template<typename... Bs>
+  constexpr bool All(bool b, Bs... bs)
+  {
+    return b && All(bs...);
+  }
+
+// Evaluate an expression for each element of a pack, for its side effects.
+template<typename... Ts>
+  void expand(Ts&&...) { }
+
+template<bool... Bs>
+  struct bool_list { };
+
+// All, for constant arguments, without recursion: the list is all true exactly when
+// shifting a true in at either end gives the same list.
+template<bool... Bs>
+  constexpr bool all_of()
+  {
+    return std::is_same<bool_list<true, Bs...>, bool_list<Bs..., true>>::value;
+  }
+
+}	// namespace impl
+
+// Type lists
+//
+// type_list<Ts...> carries a pack of types, and the operations below take it apart without
+// walking it one type at a time. The classic recursive definitions (peel off the head, recurse
+// on the tail) instantiate one template per element, and checks over packs of 30 or more types
+// run into deep, slow instantiation chains. Here:
+//
+//   Type_at<N, L>     is a single lookup: __type_pack_element where the compiler has it, and
+//                     otherwise overload resolution against a base class per element.
+//   Index_of<T, L>()  is a constexpr search over an array of flags.
+//   Filter<P, L>      keeps the types for which P<T>::value is true, and
+//   Unique<L>         the first occurrence of each type; both compute the positions to keep
+//                     with constexpr functions, and gather them with Type_at.
+//   Fold<F, L>        combines the types from left to right with a binary metafunction
+//                     F<T, U>::type, as F<F<T1, T2>::type, T3>::type and so on, so F need
+//                     not be associative. The left half of L is folded first, and its result
+//                     starts the fold of the right half, which keeps the depth logarithmic.
+//
+// make_index_sequence is logarithmic, so each of these instantiates to a depth of O(log N).
+
+template<typename... Ts>
+  struct type_list {
+    static constexpr std::size_t size() { return sizeof...(Ts); }
+  };
+
+#if defined(__has_builtin)
+#if __has_builtin(__type_pack_element)
+#define ESTD_HAS_TYPE_PACK_ELEMENT
+#endif
+#endif
+
+namespace impl {
+
+#if defined(ESTD_HAS_TYPE_PACK_ELEMENT)
+
+template<std::size_t N, typename... Ts>
+  struct type_at {
+    using type = __type_pack_element<N, Ts...>;
+  };
+
+#else
+
+template<std::size_t N, typename T>
+  struct indexed_type {
+    using type = T;
+  };
+
+template<typename S, typename... Ts>
+  struct indexed_types;
+
+template<std::size_t... Ns, typename... Ts>
+  struct indexed_types<index_sequence<Ns...>, Ts...>
+    : indexed_type<Ns, Ts>... { };
+
+// Deduction picks out the one base class with index N.
+template<std::size_t N, typename T>
+  indexed_type<N, T> select_indexed(const indexed_type<N, T>&);
+
+template<std::size_t N, typename... Ts>
+  struct type_at {
+    using type = typename decltype(select_indexed<N>(indexed_types<Estd::make_index_sequence<sizeof...(Ts)>, Ts...>{}))::type;
+  };
+
+#endif
+
+template<std::size_t N, typename L>
+  struct type_list_at;
+
+template<std::size_t N, typename... Ts>
+  struct type_list_at<N, type_list<Ts...>> {
+    static_assert(N < sizeof...(Ts), "Type_at: index out of range");
+
+    using type = typename type_at<N, Ts...>::type;
+  };
+
+// Flags, stored as an array so that constexpr functions can search them. The extra
+// element keeps the array from being empty.
+template<bool... Bs>
+  struct flags {
+    static constexpr bool value[sizeof...(Bs) + 1] = { Bs..., false };
+    static constexpr std::size_t size = sizeof...(Bs);
+  };
+
+template<bool... Bs>
+  constexpr bool flags<Bs...>::value[sizeof...(Bs) + 1];
+
+// The position of the first true flag in p[i, n), or n.
+constexpr std::size_t first_true(const bool* p, std::size_t n, std::size_t i = 0)
+{
+  return i == n || p[i] ? i : first_true(p, n, i + 1);
+}
+
+constexpr std::size_t count_true(const bool* p, std::size_t n)
+{
+  return n == 0 ? 0 : p[n - 1] + count_true(p, n - 1);
+}
+
+// The position of the true flag with k true flags before it.
+constexpr std::size_t nth_true(const bool* p, std::size_t k, std::size_t i = 0)
+{
+  return p[i] ? (k == 0 ? i : nth_true(p, k - 1, i + 1)) : nth_true(p, k, i + 1);
+}
+
+template<typename T, typename L>
+  struct index_of;
+
+template<typename T, typename... Ts>
+  struct index_of<T, type_list<Ts...>> {
+    using f = flags<std::is_same<T, Ts>::value...>;
+
+    static constexpr std::size_t value = first_true(f::value, f::size);
+  };
+
+// The types of L at Offset + N, for each N.
+template<typename L, std::size_t Offset, typename S>
+  struct select_range;
+
+template<typename... Ts, std::size_t Offset, std::size_t... Ns>
+  struct select_range<type_list<Ts...>, Offset, index_sequence<Ns...>> {
+    using type = type_list<typename type_at<Offset + Ns, Ts...>::type...>;
+  };
+
+// The types of L whose flags in F are true.
+template<typename L, typename F, typename S = Estd::make_index_sequence<count_true(F::value, F::size)>>
+  struct select_flagged;
+
+template<typename... Ts, typename F, std::size_t... Ks>
+  struct select_flagged<type_list<Ts...>, F, index_sequence<Ks...>> {
+    using type = type_list<typename type_at<nth_true(F::value, Ks), Ts...>::type...>;
+  };
+
+template<template<typename> class P, typename L>
+  struct filter;
+
+template<template<typename> class P, typename... Ts>
+  struct filter<P, type_list<Ts...>>
+    : select_flagged<type_list<Ts...>, flags<bool(P<Ts>::value)...>> { };
+
+template<typename L, typename S>
+  struct unique;
+
+template<typename... Ts, std::size_t... Ns>
+  struct unique<type_list<Ts...>, index_sequence<Ns...>>
+    : select_flagged<type_list<Ts...>, flags<(index_of<Ts, type_list<Ts...>>::value == Ns)...>> { };
+
+template<std::size_t N, typename L>
+  using Take = typename select_range<L, 0, Estd::make_index_sequence<N>>::type;
+
+template<std::size_t N, typename L>
+  using Drop = typename select_range<L, N, Estd::make_index_sequence<L::size() - N>>::type;
+
+// A left fold of the types of L onto Acc.
+template<template<typename, typename> class F, typename Acc, typename L>
+  struct fold_left;
+
+template<template<typename, typename> class F, typename Acc>
+  struct fold_left<F, Acc, type_list<>> {
+    using type = Acc;
+  };
+
+template<template<typename, typename> class F, typename Acc, typename T>
+  struct fold_left<F, Acc, type_list<T>> {
+    using type = typename F<Acc, T>::type;
+  };
+
+template<template<typename, typename> class F, typename Acc, typename... Ts>
+  struct fold_left<F, Acc, type_list<Ts...>> {
+    static constexpr std::size_t half = sizeof...(Ts) / 2;
+
+    using type = typename fold_left<F,
+                                    typename fold_left<F, Acc, Take<half, type_list<Ts...>>>::type,
+                                    Drop<half, type_list<Ts...>>>::type;
+  };
+
+// A left fold onto the first type. An empty list has no result.
+template<template<typename, typename> class F, typename L>
+  struct fold;
+
+template<template<typename, typename> class F>
+  struct fold<F, type_list<>> { };
+
+template<template<typename, typename> class F, typename T, typename... Ts>
+  struct fold<F, type_list<T, Ts...>>
+    : fold_left<F, T, type_list<Ts...>> { };
+
+}	// namespace impl
+
+template<std::size_t N, typename L>
+  using Type_at = typename impl::type_list_at<N, L>::type;
+
+// The position of the first T in L, or the size of L if there is none.
+template<typename T, typename L>
+  constexpr std::size_t Index_of()
+  {
+    return impl::index_of<T, L>::value;
+  }
+
+template<template<typename> class P, typename L>
+  using Filter = typename impl::filter<P, L>::type;
+
+template<typename L>
+  using Unique = typename impl::unique<L, make_index_sequence<L::size()>>::type;
+
+template<template<typename, typename> class F, typename L>
+  using Fold = typename impl::fold<F, L>::type;
+
 }	// namespace Estd
 
 #endif	// META_SUPPORT_H
@@ -0,0 +1,101 @@
+#ifndef NICHE_H
+#define NICHE_H
+
+#include "constraints.h"
+#include <cstdint>
+#include <cstring>
+
+// A niche of a type is a value that its uses never take, such as the null pointer of a
+// pointer that always points at something, or a sentinel that marks an invalid handle. A
+// wrapper that must record "no value" can store the niche in place of a separate flag, and
+// be no larger than the type itself: optional<T> does this, so that optional<Handle> has
+// the size of Handle, instead of Handle plus a bool padded to its alignment.
+//
+// niche_traits<T> describes the niche of T. When available is true, it also has
+//   empty_value()    - the niche, as a T
+//   is_empty(x)      - is x the niche?
+// The primary template has no niche. The library gives these niches:
+//   T*               - the null pointer
+//   double, float    - one quiet NaN, whose payload the floating-point operations never
+//                      make; every other NaN is still a value
+//   enumerations declared with ESTD_ENUM - the value after the last enumerator, when the
+//                      underlying type has one (see enum.h)
+// and sentinel_niche<T, V> makes V the niche of an integer or enumeration type T:
+//
+//   namespace Estd {
+//   template<>
+//     struct niche_traits<socket_handle> : sentinel_niche<socket_handle, socket_handle(-1)> { };
+//   }
+//
+// The niche is then not a value: an optional made from it is empty. A type with a niche is
+// copy assignable, since a wrapper assigns the niche over the value to empty itself.
+
+namespace Estd {
+
+template<typename T, typename = void>
+  struct niche_traits {
+    static constexpr bool available = false;
+  };
+
+template<typename T, T V>
+  struct sentinel_niche {
+    static_assert(Integral<T>() || Enum<T>(), "sentinel_niche: T must be an integer or an enumeration");
+
+    static constexpr bool available = true;
+
+    static constexpr T empty_value() { return V; }
+    static constexpr bool is_empty(T x) { return x == V; }
+  };
+
+template<typename T>
+  struct niche_traits<T*> {
+    static constexpr bool available = true;
+
+    static constexpr T* empty_value() { return nullptr; }
+    static constexpr bool is_empty(T* p) { return p == nullptr; }
+  };
+
+namespace impl {
+
+// The niche of a floating-point type F whose representation is the unsigned integer U.
+// The comparisons are of representations, since a NaN compares unequal to itself.
+template<typename F, typename U, U Bits>
+  struct nan_niche {
+    static_assert(sizeof(F) == sizeof(U), "nan_niche: F and U must have the same size");
+
+    static constexpr bool available = true;
+
+    static F empty_value()
+    {
+      F x;
+      U b = Bits;
+      std::memcpy(&x, &b, sizeof x);
+      return x;
+    }
+
+    static bool is_empty(F x)
+    {
+      U b;
+      std::memcpy(&b, &x, sizeof x);
+      return b == Bits;
+    }
+  };
+
+}	// namespace impl
+
+template<>
+  struct niche_traits<double> : impl::nan_niche<double, std::uint64_t, 0x7ff8deadbeefcafeu> { };
+
+template<>
+  struct niche_traits<float> : impl::nan_niche<float, std::uint32_t, 0x7fdeadbeu> { };
+
+// Does T have a niche?
+template<typename T>
+  constexpr bool Has_niche()
+  {
+    return niche_traits<T>::available;
+  }
+
+}	// namespace Estd
+
+#endif	// NICHE_H
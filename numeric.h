@@ -0,0 +1,102 @@
+#ifndef NUMERIC_H
+#define NUMERIC_H
+
+#include "constraints.h"
+#include <cstddef>
+#include <iterator>
+#include <limits>
+
+// Numeric reductions over Arithmetic ranges - compare pg. 1176.
+// Unlike std::accumulate, the result type is not the type of the initial value:
+// integers are accumulated in the next larger type, and floating point values in
+// at least double precision.
+
+namespace Estd {
+
+// Reduction kernels.
+#include "impl/reduce.h"
+
+template<typename T>
+  using Accumulator_type = typename impl::accumulator_type<T>::type;
+
+// The mean of integers is a double; the mean of floating point values has the accumulator type.
+template<typename T>
+  using Mean_type = Conditional<Integral<T>(), double, Accumulator_type<T>>;
+
+// sum
+
+template<typename I>
+  Accumulator_type<Value_type<I>> sum(I first, I last)
+  {
+    static_assert(Input_iterator<I>(), "sum: requires input iterators");
+    static_assert(Arithmetic<Value_type<I>>(), "sum: requires an arithmetic value type");
+
+    std::size_t n;
+    return impl::sum<Accumulator_type<Value_type<I>>>(first, last, n, boolean_constant<Pointer<I>()>{});
+  }
+
+template<typename R>
+  auto sum(const R& r)
+    -> Enable_if<Range<R>(), Accumulator_type<Value_type<R>>>
+  {
+    static_assert(Arithmetic<Value_type<R>>(), "sum: requires an arithmetic value type");
+
+    std::size_t n;
+    return impl::sum_range<Accumulator_type<Value_type<R>>>(r, n, boolean_constant<Contiguous_range<R>()>{});
+  }
+
+// mean
+// The mean of an empty range is a quiet NaN.
+
+template<typename I>
+  Mean_type<Value_type<I>> mean(I first, I last)
+  {
+    static_assert(Input_iterator<I>(), "mean: requires input iterators");
+    static_assert(Arithmetic<Value_type<I>>(), "mean: requires an arithmetic value type");
+
+    using M = Mean_type<Value_type<I>>;
+    std::size_t n;
+    M s = impl::sum<Accumulator_type<Value_type<I>>>(first, last, n, boolean_constant<Pointer<I>()>{});
+    return n ? s / static_cast<M>(n) : std::numeric_limits<M>::quiet_NaN();
+  }
+
+template<typename R>
+  auto mean(const R& r)
+    -> Enable_if<Range<R>(), Mean_type<Value_type<R>>>
+  {
+    static_assert(Arithmetic<Value_type<R>>(), "mean: requires an arithmetic value type");
+
+    using M = Mean_type<Value_type<R>>;
+    std::size_t n;
+    M s = impl::sum_range<Accumulator_type<Value_type<R>>>(r, n, boolean_constant<Contiguous_range<R>()>{});
+    return n ? s / static_cast<M>(n) : std::numeric_limits<M>::quiet_NaN();
+  }
+
+// dot
+// The products are formed in the accumulator type, so an int32 dot product can't overflow
+// in the multiplication.
+
+template<typename I1, typename I2>
+  Accumulator_type<Common_type<Value_type<I1>, Value_type<I2>>> dot(I1 first1, I1 last1, I2 first2)
+  {
+    static_assert(Input_iterator<I1>() && Input_iterator<I2>(), "dot: requires input iterators");
+    static_assert(Arithmetic<Value_type<I1>>() && Arithmetic<Value_type<I2>>(), "dot: requires arithmetic value types");
+
+    using A = Accumulator_type<Common_type<Value_type<I1>, Value_type<I2>>>;
+    return impl::dot<A>(first1, last1, first2, boolean_constant<Pointer<I1>() && Pointer<I2>()>{});
+  }
+
+// The ranges must have the same length.
+template<typename R1, typename R2>
+  auto dot(const R1& r1, const R2& r2)
+    -> Enable_if<Range<R1>() && Range<R2>(), Accumulator_type<Common_type<Value_type<R1>, Value_type<R2>>>>
+  {
+    static_assert(Arithmetic<Value_type<R1>>() && Arithmetic<Value_type<R2>>(), "dot: requires arithmetic value types");
+
+    using A = Accumulator_type<Common_type<Value_type<R1>, Value_type<R2>>>;
+    return impl::dot_range<A>(r1, r2, boolean_constant<Contiguous_range<R1>() && Contiguous_range<R2>()>{});
+  }
+
+}	// namespace Estd
+
+#endif	// NUMERIC_H
@@ -0,0 +1,401 @@
+#ifndef NUMERIC_ARRAY_H
+#define NUMERIC_ARRAY_H
+
+#include "constraints.h"
+#include "memory.h"
+#include "platform.h"
+#include <cstddef>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+// numeric_array<T> is an array of numbers with element-wise arithmetic - compare valarray,
+// pg. 1166. +, -, * and / on arrays don't compute anything: they build an expression node
+// that records the operation and its operands. The work happens when an expression is
+// assigned to an array, in one loop that computes each element of the result from the
+// elements of the operands. So
+//
+//   a = b * c + d;
+//
+// allocates nothing and makes one pass over memory, where the eager form makes two passes
+// and a temporary array per operator. The loop is a plain indexed loop over pointers, which
+// the compiler vectorizes when it vectorizes loops at all (-O3 for GCC, -O2 for Clang).
+//
+// The element type of a node is the result type of its operator on the element types of
+// its operands: the node for b * c has Multiply_result<T, U> elements, so short * short is
+// an array of int, as it is for the scalars. Assignment converts to the element type of
+// the array. A scalar operand stands for an array of that value.
+//
+// The operands of an expression must have the same size. An expression refers to the
+// arrays in it, so one held in an auto variable must not outlive them; assign it to a
+// numeric_array, or call eval, to keep the values.
+//
+// Since the result element i depends only on element i of each operand, an array may
+// appear on both sides, as in a = a * b. If the sizes differ, assignment builds the result
+// in new storage.
+
+namespace Estd {
+
+template<typename T>
+  class numeric_array;
+
+// The base of the expression nodes. Deriving from it puts the operators below in reach of
+// argument-dependent lookup for every node.
+struct array_expression_base { };
+
+namespace impl {
+
+// The operations of the nodes.
+
+struct array_plus {
+  template<typename T, typename U>
+    using result = Plus_result<T, U>;
+
+  template<typename T, typename U>
+    static result<T, U> apply(T a, U b) { return a + b; }
+};
+
+struct array_minus {
+  template<typename T, typename U>
+    using result = Minus_result<T, U>;
+
+  template<typename T, typename U>
+    static result<T, U> apply(T a, U b) { return a - b; }
+};
+
+struct array_multiplies {
+  template<typename T, typename U>
+    using result = Multiply_result<T, U>;
+
+  template<typename T, typename U>
+    static result<T, U> apply(T a, U b) { return a * b; }
+};
+
+struct array_divides {
+  template<typename T, typename U>
+    using result = Divide_result<T, U>;
+
+  template<typename T, typename U>
+    static result<T, U> apply(T a, U b) { return a / b; }
+};
+
+// The leaves. An array enters an expression as a pointer and a size, so the evaluation
+// loop reads through plain pointers; a scalar enters as its value.
+
+template<typename T>
+  class array_leaf : public array_expression_base {
+  public:
+    using value_type = T;
+
+    array_leaf(const T* p, std::size_t n) : p(p), n(n) { }
+
+    std::size_t size() const { return n; }
+    const T& operator[](std::size_t i) const { return p[i]; }
+
+  private:
+    const T* p;
+    std::size_t n;
+  };
+
+template<typename T>
+  class array_scalar {
+  public:
+    using value_type = T;
+
+    explicit array_scalar(const T& x) : x(x) { }
+
+    const T& operator[](std::size_t) const { return x; }
+
+  private:
+    T x;
+  };
+
+// How an operand of an operator is held in a node: an array as a leaf, a node as itself,
+// and anything else as a scalar.
+
+template<typename T>
+  struct array_operand {
+    using type = array_scalar<T>;
+    static type make(const T& x) { return type(x); }
+  };
+
+template<typename T>
+  struct array_operand<numeric_array<T>> {
+    using type = array_leaf<T>;
+    static type make(const numeric_array<T>& a) { return type(a.data(), a.size()); }
+  };
+
+template<typename T>
+  using Array_operand = typename array_operand<T>::type;
+
+template<typename T>
+  constexpr bool Array_scalar()
+  {
+    return !Derived<Array_operand<T>, array_expression_base>();
+  }
+
+// Array expressions are the arrays and the nodes.
+template<typename T>
+  constexpr bool Array_expression()
+  {
+    return !Array_scalar<T>();
+  }
+
+// The size of an expression is the size of its array operands. At least one of the
+// operands of a node is an array expression.
+
+template<typename L, typename R>
+  std::size_t array_size(const L& l, const R&, boolean_constant<false>) { return l.size(); }
+
+template<typename L, typename R>
+  std::size_t array_size(const L&, const R& r, boolean_constant<true>) { return r.size(); }
+
+template<typename Op, typename L, typename R>
+  class array_binary : public array_expression_base {
+  public:
+    using value_type = typename Op::template result<Value_type<L>, Value_type<R>>;
+
+    array_binary(const L& l, const R& r) : l(l), r(r) { }
+
+    std::size_t size() const
+    {
+      return array_size(l, r, boolean_constant<!Derived<L, array_expression_base>()>{});
+    }
+
+    value_type operator[](std::size_t i) const { return Op::apply(l[i], r[i]); }
+
+  private:
+    L l;
+    R r;
+  };
+
+template<typename E>
+  class array_negate : public array_expression_base {
+  public:
+    using value_type = Unary_minus_result<Value_type<E>>;
+
+    explicit array_negate(const E& e) : e(e) { }
+
+    std::size_t size() const { return e.size(); }
+    value_type operator[](std::size_t i) const { return -e[i]; }
+
+  private:
+    E e;
+  };
+
+template<typename E>
+  struct array_operand<array_negate<E>> {
+    using type = array_negate<E>;
+    static const type& make(const type& e) { return e; }
+  };
+
+template<typename Op, typename L, typename R>
+  struct array_operand<array_binary<Op, L, R>> {
+    using type = array_binary<Op, L, R>;
+    static const type& make(const type& e) { return e; }
+  };
+
+// The element type of an operand; a scalar is its own element type.
+template<typename T>
+  using Array_value_type = Value_type<Array_operand<T>>;
+
+// Can Op apply to L and R? One of them must be an array expression.
+template<typename Op, typename L, typename R>
+  constexpr bool Array_operands()
+  {
+    return (Array_expression<L>() || Array_expression<R>())
+        && Substitution_succeeded<typename Op::template result<Array_value_type<L>, Array_value_type<R>>>();
+  }
+
+template<typename Op, typename L, typename R>
+  using Array_binary = array_binary<Op, Array_operand<L>, Array_operand<R>>;
+
+template<typename Op, typename L, typename R>
+  Array_binary<Op, L, R> make_array_binary(const L& l, const R& r)
+  {
+    return Array_binary<Op, L, R>(array_operand<L>::make(l), array_operand<R>::make(r));
+  }
+
+// The evaluation loop. out is either disjoint from the arrays in e or one of them, and
+// element i is written after the elements i of the operands are read, so the iterations
+// are independent.
+template<typename T, typename E>
+  void array_assign(T* out, const E& e, std::size_t n)
+  {
+    ESTD_IVDEP
+    for (std::size_t i = 0; i != n; ++i)
+      out[i] = static_cast<T>(e[i]);
+  }
+
+}	// namespace impl
+
+template<typename T>
+  class numeric_array {
+    static_assert(Regular<T>(), "numeric_array: the element type must be Regular");
+
+    using storage = std::vector<T, aligned_allocator<T>>;
+
+  public:
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = T*;
+    using const_iterator = const T*;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    numeric_array() = default;
+
+    // n value-initialized elements.
+    explicit numeric_array(size_type n) : v(n) { }
+
+    numeric_array(size_type n, const T& x) : v(n, x) { }
+
+    numeric_array(std::initializer_list<T> list) : v(list) { }
+
+    // Evaluates e.
+    template<typename E,
+             typename = Enable_if<impl::Array_expression<E>()>>
+      numeric_array(const E& e)
+        : v(impl::array_operand<E>::make(e).size())
+      {
+        impl::array_assign(data(), impl::array_operand<E>::make(e), size());
+      }
+
+    numeric_array(const numeric_array&) = default;
+    numeric_array(numeric_array&&) = default;
+    numeric_array& operator=(const numeric_array&) = default;
+    numeric_array& operator=(numeric_array&&) = default;
+
+    // Evaluates e into this array, in place when the sizes agree.
+    template<typename E>
+      auto operator=(const E& e)
+        -> Enable_if<impl::Array_expression<E>() && !Same<E, numeric_array>(), numeric_array&>
+      {
+        auto x = impl::array_operand<E>::make(e);
+        if (x.size() == size()) {
+          impl::array_assign(data(), x, size());
+        } else {
+          numeric_array tmp(e);
+          swap(tmp);
+        }
+        return *this;
+      }
+
+    // Sets every element to x.
+    numeric_array& operator=(const T& x)
+    {
+      for (T& y : v)
+        y = x;
+      return *this;
+    }
+
+    // Compound assignment, from an expression or a scalar.
+
+    template<typename E>
+      auto operator+=(const E& e)
+        -> Enable_if<impl::Array_operands<impl::array_plus, numeric_array, E>(), numeric_array&>
+      {
+        return *this = impl::make_array_binary<impl::array_plus>(*this, e);
+      }
+
+    template<typename E>
+      auto operator-=(const E& e)
+        -> Enable_if<impl::Array_operands<impl::array_minus, numeric_array, E>(), numeric_array&>
+      {
+        return *this = impl::make_array_binary<impl::array_minus>(*this, e);
+      }
+
+    template<typename E>
+      auto operator*=(const E& e)
+        -> Enable_if<impl::Array_operands<impl::array_multiplies, numeric_array, E>(), numeric_array&>
+      {
+        return *this = impl::make_array_binary<impl::array_multiplies>(*this, e);
+      }
+
+    template<typename E>
+      auto operator/=(const E& e)
+        -> Enable_if<impl::Array_operands<impl::array_divides, numeric_array, E>(), numeric_array&>
+      {
+        return *this = impl::make_array_binary<impl::array_divides>(*this, e);
+      }
+
+    void swap(numeric_array& x) noexcept { v.swap(x.v); }
+
+    size_type size() const { return v.size(); }
+    bool empty() const { return v.empty(); }
+
+    // Resizing loses the values, as for valarray.
+    void resize(size_type n, const T& x = T())
+    {
+      storage tmp(n, x);
+      v.swap(tmp);
+    }
+
+    T* data() { return v.data(); }
+    const T* data() const { return v.data(); }
+
+    T& operator[](size_type i) { return v[i]; }
+    const T& operator[](size_type i) const { return v[i]; }
+
+    iterator begin() { return data(); }
+    iterator end() { return data() + size(); }
+    const_iterator begin() const { return data(); }
+    const_iterator end() const { return data() + size(); }
+
+  private:
+    storage v;
+  };
+
+template<typename T>
+  inline void swap(numeric_array<T>& a, numeric_array<T>& b) noexcept { a.swap(b); }
+
+// The operators build nodes; they take any pair of an array expression and an array
+// expression or scalar for which the element operation is defined.
+
+template<typename L, typename R>
+  inline auto operator+(const L& l, const R& r)
+    -> Enable_if<impl::Array_operands<impl::array_plus, L, R>(), impl::Array_binary<impl::array_plus, L, R>>
+  {
+    return impl::make_array_binary<impl::array_plus>(l, r);
+  }
+
+template<typename L, typename R>
+  inline auto operator-(const L& l, const R& r)
+    -> Enable_if<impl::Array_operands<impl::array_minus, L, R>(), impl::Array_binary<impl::array_minus, L, R>>
+  {
+    return impl::make_array_binary<impl::array_minus>(l, r);
+  }
+
+template<typename L, typename R>
+  inline auto operator*(const L& l, const R& r)
+    -> Enable_if<impl::Array_operands<impl::array_multiplies, L, R>(), impl::Array_binary<impl::array_multiplies, L, R>>
+  {
+    return impl::make_array_binary<impl::array_multiplies>(l, r);
+  }
+
+template<typename L, typename R>
+  inline auto operator/(const L& l, const R& r)
+    -> Enable_if<impl::Array_operands<impl::array_divides, L, R>(), impl::Array_binary<impl::array_divides, L, R>>
+  {
+    return impl::make_array_binary<impl::array_divides>(l, r);
+  }
+
+template<typename E>
+  inline auto operator-(const E& e)
+    -> Enable_if<impl::Array_expression<E>(), impl::array_negate<impl::Array_operand<E>>>
+  {
+    return impl::array_negate<impl::Array_operand<E>>(impl::array_operand<E>::make(e));
+  }
+
+// The value of an expression, as an array of its element type.
+template<typename E>
+  auto eval(const E& e)
+    -> Enable_if<impl::Array_expression<E>(), numeric_array<impl::Array_value_type<E>>>
+  {
+    return numeric_array<impl::Array_value_type<E>>(e);
+  }
+
+}	// namespace Estd
+
+#endif	// NUMERIC_ARRAY_H
@@ -0,0 +1,394 @@
+#ifndef OPERATORS_H
+#define OPERATORS_H
+
+#include "core.h"
+
+// <=> and the comparison categories, when both the compiler and the library have them.
+#if defined(__cpp_impl_three_way_comparison) && __cpp_impl_three_way_comparison >= 201907L
+#if defined(__has_include)
+#if __has_include(<compare>)
+#include <compare>
+#define ESTD_HAS_THREE_WAY
+#endif
+#endif
+#endif
+
+// Detectors for the operators: Has_plus<T, U>(), Plus_result<T, U>, and so on for every
+// overloadable operator, and Static_castable.
+
+namespace Estd {
+
+// Tests for operators; result types of operators.
+
+#include "impl/operators.h"
+
+template<typename T, typename U>
+  using Subscript_result = typename impl::get_subscript_result<T, U>::type;
+
+template<typename T, typename U>
+  constexpr bool Has_subscript()
+  {
+    return Substitution_succeeded<Subscript_result<T, U>>();
+  }
+
+template<typename T>
+  using Post_increment_result = typename impl::get_post_increment_result<T>::type;
+
+template<typename T>
+  constexpr bool Has_post_increment()
+  {
+    return Substitution_succeeded<Post_increment_result<T>>();
+  }
+
+template<typename T>
+  using Post_decrement_result = typename impl::get_post_decrement_result<T>::type;
+
+template<typename T>
+  constexpr bool Has_post_decrement()
+  {
+    return Substitution_succeeded<Post_decrement_result<T>>();
+  }
+
+template<typename T>
+  using Pre_increment_result = typename impl::get_pre_increment_result<T>::type;
+
+template<typename T>
+  constexpr bool Has_pre_increment()
+  {
+    return Substitution_succeeded<Pre_increment_result<T>>();
+  }
+
+template<typename T>
+  using Pre_decrement_result = typename impl::get_pre_decrement_result<T>::type;
+
+template<typename T>
+  constexpr bool Has_pre_decrement()
+  {
+    return Substitution_succeeded<Pre_decrement_result<T>>();
+  }
+
+template<typename T>
+  using Complement_result = typename impl::get_complement_result<T>::type;
+
+template<typename T>
+  constexpr bool Has_complement()
+  {
+    return Substitution_succeeded<Complement_result<T>>();
+  }
+
+template<typename T>
+  using Not_result = typename impl::get_not_result<T>::type;
+
+template<typename T>
+  constexpr bool Has_not()
+  {
+    return Substitution_succeeded<Not_result<T>>();
+  }
+
+template<typename T>
+  using Unary_minus_result = typename impl::get_unary_minus_result<T>::type;
+
+template<typename T>
+  constexpr bool Has_unary_minus()
+  {
+    return Substitution_succeeded<Unary_minus_result<T>>();
+  }
+
+template<typename T>
+  using Unary_plus_result = typename impl::get_unary_plus_result<T>::type;
+
+template<typename T>
+  constexpr bool Has_unary_plus()
+  {
+    return Substitution_succeeded<Unary_plus_result<T>>();
+  }
+
+template<typename T>
+  using Address_of_result = typename impl::get_address_of_result<T>::type;
+
+template<typename T>
+  constexpr bool Has_address_of()
+  {
+    return Substitution_succeeded<Address_of_result<T>>();
+  }
+
+template<typename T>
+  using Dereference_result = typename impl::get_dereference_result<T>::type;
+
+template<typename T>
+  constexpr bool Has_dereference()
+  {
+    return Substitution_succeeded<Dereference_result<T>>();
+  }
+
+template<typename T, typename U = T>
+  using Multiply_result = typename impl::get_multiply_result<T, U>::type;
+
+template<typename T, typename U = T>
+  constexpr bool Has_multiply()
+  {
+    return Substitution_succeeded<Multiply_result<T, U>>();
+  }
+
+template<typename T, typename U = T>
+  using Divide_result = typename impl::get_divide_result<T, U>::type;
+
+template<typename T, typename U = T>
+  constexpr bool Has_divide()
+  {
+    return Substitution_succeeded<Divide_result<T, U>>();
+  }
+
+template<typename T, typename U = T>
+  using Modulo_result = typename impl::get_modulo_result<T, U>::type;
+
+template<typename T, typename U = T>
+  constexpr bool Has_modulo()
+  {
+    return Substitution_succeeded<Modulo_result<T, U>>();
+  }
+
+template<typename T, typename U = T>
+  using Plus_result = typename impl::get_plus_result<T, U>::type;
+
+template<typename T, typename U = T>
+  constexpr bool Has_plus()
+  {
+    return Substitution_succeeded<Plus_result<T, U>>();
+  }
+
+template<typename T, typename U = T>
+  using Minus_result = typename impl::get_minus_result<T, U>::type;
+
+template<typename T, typename U = T>
+  constexpr bool Has_minus()
+  {
+    return Substitution_succeeded<Minus_result<T, U>>();
+  }
+
+template<typename T, typename U = T>
+  using Left_shift_result = typename impl::get_left_shift_result<T, U>::type;
+
+template<typename T, typename U = T>
+  constexpr bool Has_left_shift()
+  {
+    return Substitution_succeeded<Left_shift_result<T, U>>();
+  }
+
+template<typename T, typename U = T>
+  using Right_shift_result = typename impl::get_right_shift_result<T, U>::type;
+
+template<typename T, typename U = T>
+  constexpr bool Has_right_shift()
+  {
+    return Substitution_succeeded<Right_shift_result<T, U>>();
+  }
+
+template<typename T, typename U = T>
+  using Less_result = typename impl::get_less_result<T, U>::type;
+
+template<typename T, typename U = T>
+  constexpr bool Has_less()
+  {
+    return Substitution_succeeded<Less_result<T, U>>();
+  }
+
+template<typename T, typename U = T>
+  using Greater_result = typename impl::get_greater_result<T, U>::type;
+
+template<typename T, typename U = T>
+  constexpr bool Has_greater()
+  {
+    return Substitution_succeeded<Greater_result<T, U>>();
+  }
+
+template<typename T, typename U = T>
+  using Less_equal_result = typename impl::get_less_equal_result<T, U>::type;
+
+template<typename T, typename U = T>
+  constexpr bool Has_less_equal()
+  {
+    return Substitution_succeeded<Less_equal_result<T, U>>();
+  }
+
+template<typename T, typename U = T>
+  using Greater_equal_result = typename impl::get_greater_equal_result<T, U>::type;
+
+template<typename T, typename U = T>
+  constexpr bool Has_greater_equal()
+  {
+    return Substitution_succeeded<Greater_equal_result<T, U>>();
+  }
+
+template<typename T, typename U = T>
+  using Equal_result = typename impl::get_equal_result<T, U>::type;
+
+template<typename T, typename U = T>
+  constexpr bool Has_equal()
+  {
+    return Substitution_succeeded<Equal_result<T, U>>();
+  }
+
+template<typename T, typename U = T>
+  using Not_equal_result = typename impl::get_not_equal_result<T, U>::type;
+
+template<typename T, typename U = T>
+  constexpr bool Has_not_equal()
+  {
+    return Substitution_succeeded<Not_equal_result<T, U>>();
+  }
+
+template<typename T, typename U = T>
+  using Three_way_result = typename impl::get_three_way_result<T, U>::type;
+
+template<typename T, typename U = T>
+  constexpr bool Has_three_way()
+  {
+    return Substitution_succeeded<Three_way_result<T, U>>();
+  }
+
+template<typename T, typename U = T>
+  using Bitwise_and_result = typename impl::get_bitwise_and_result<T, U>::type;
+
+template<typename T, typename U = T>
+  constexpr bool Has_bitwise_and()
+  {
+    return Substitution_succeeded<Bitwise_and_result<T, U>>();
+  }
+
+template<typename T, typename U = T>
+  using Bitwise_xor_result = typename impl::get_bitwise_xor_result<T, U>::type;
+
+template<typename T, typename U = T>
+  constexpr bool Has_bitwise_xor()
+  {
+    return Substitution_succeeded<Bitwise_xor_result<T, U>>();
+  }
+
+template<typename T, typename U = T>
+  using Bitwise_or_result = typename impl::get_bitwise_or_result<T, U>::type;
+
+template<typename T, typename U = T>
+  constexpr bool Has_bitwise_or()
+  {
+    return Substitution_succeeded<Bitwise_or_result<T, U>>();
+  }
+
+template<typename T, typename U = T>
+  using And_result = typename impl::get_and_result<T, U>::type;
+
+template<typename T, typename U = T>
+  constexpr bool Has_and()
+  {
+    return Substitution_succeeded<And_result<T, U>>();
+  }
+
+template<typename T, typename U = T>
+  using Or_result = typename impl::get_or_result<T, U>::type;
+
+template<typename T, typename U = T>
+  constexpr bool Has_or()
+  {
+    return Substitution_succeeded<Or_result<T, U>>();
+  }
+
+template<typename T, typename U = T>
+  using Multiply_assign_result = typename impl::get_multiply_assign_result<T, U>::type;
+
+template<typename T, typename U = T>
+  constexpr bool Has_multiply_assign()
+  {
+    return Substitution_succeeded<Multiply_assign_result<T, U>>();
+  }
+
+template<typename T, typename U = T>
+  using Divide_assign_result = typename impl::get_divide_assign_result<T, U>::type;
+
+template<typename T, typename U = T>
+  constexpr bool Has_divide_assign()
+  {
+    return Substitution_succeeded<Divide_assign_result<T, U>>();
+  }
+
+template<typename T, typename U = T>
+  using Modulo_assign_result = typename impl::get_modulo_assign_result<T, U>::type;
+
+template<typename T, typename U = T>
+  constexpr bool Has_modulo_assign()
+  {
+    return Substitution_succeeded<Modulo_assign_result<T, U>>();
+  }
+
+template<typename T, typename U = T>
+  using Plus_assign_result = typename impl::get_plus_assign_result<T, U>::type;
+
+template<typename T, typename U = T>
+  constexpr bool Has_plus_assign()
+  {
+    return Substitution_succeeded<Plus_assign_result<T, U>>();
+  }
+
+template<typename T, typename U = T>
+  using Minus_assign_result = typename impl::get_minus_assign_result<T, U>::type;
+
+template<typename T, typename U = T>
+  constexpr bool Has_minus_assign()
+  {
+    return Substitution_succeeded<Minus_assign_result<T, U>>();
+  }
+
+template<typename T, typename U = T>
+  using Left_shift_assign_result = typename impl::get_left_shift_assign_result<T, U>::type;
+
+template<typename T, typename U = T>
+  constexpr bool Has_left_shift_assign()
+  {
+    return Substitution_succeeded<Left_shift_assign_result<T, U>>();
+  }
+
+template<typename T, typename U = T>
+  using Right_shift_assign_result = typename impl::get_right_shift_assign_result<T, U>::type;
+
+template<typename T, typename U = T>
+  constexpr bool Has_right_shift_assign()
+  {
+    return Substitution_succeeded<Right_shift_assign_result<T, U>>();
+  }
+
+template<typename T, typename U = T>
+  using Bitwise_and_assign_result = typename impl::get_bitwise_and_assign_result<T, U>::type;
+
+template<typename T, typename U = T>
+  constexpr bool Has_bitwise_and_assign()
+  {
+    return Substitution_succeeded<Bitwise_and_assign_result<T, U>>();
+  }
+
+template<typename T, typename U = T>
+  using Bitwise_or_assign_result = typename impl::get_bitwise_or_assign_result<T, U>::type;
+
+template<typename T, typename U = T>
+  constexpr bool Has_bitwise_or_assign()
+  {
+    return Substitution_succeeded<Bitwise_or_assign_result<T, U>>();
+  }
+
+template<typename T, typename U = T>
+  using Bitwise_xor_assign_result = typename impl::get_bitwise_xor_assign_result<T, U>::type;
+
+template<typename T, typename U = T>
+  constexpr bool Has_bitwise_xor_assign()
+  {
+    return Substitution_succeeded<Bitwise_xor_assign_result<T, U>>();
+  }
+
+// Is static_cast<U>(t) a valid expression?
+template<typename T, typename U>
+  constexpr bool Static_castable()
+  {
+    return Substitution_succeeded<typename impl::get_static_cast_result<T, U>::type>();
+  }
+
+}	// namespace Estd
+
+#endif	// OPERATORS_H
@@ -0,0 +1,348 @@
+#ifndef OPTIONAL_H
+#define OPTIONAL_H
+
+#include "constraints.h"
+#include "niche.h"
+#include "platform.h"
+#include <exception>
+#include <new>
+#include <utility>
+
+// optional<T> is a T or nothing, after C++17's std::optional.
+//
+// When T has a niche (see niche.h), optional<T> is just a T, and is empty when the T is
+// the niche value; an array of optional<T*> is an array of pointers. For other types it
+// is a T and a bool.
+//
+// optional<T> is trivially copyable when T is, and trivially destructible when T is, so
+// it can be copied with memcpy, kept in the containers that rely on that, and compared
+// bytewise, as T can.
+//
+// The constructors and the observers are constexpr. So are the modifiers, from C++14, when
+// T has a niche: without one they construct T in the union with placement new, which a
+// constant expression can't do before C++20.
+
+namespace Estd {
+
+struct nullopt_t {
+  struct tag { };
+  constexpr explicit nullopt_t(tag) { }
+};
+
+constexpr nullopt_t nullopt{nullopt_t::tag{}};
+
+struct in_place_t {
+  constexpr explicit in_place_t() = default;
+};
+
+constexpr in_place_t in_place{};
+
+class bad_optional_access : public std::exception {
+public:
+  const char* what() const noexcept override { return "bad_optional_access"; }
+};
+
+namespace impl {
+
+// The storage of optional<T>. Each has engaged(), get(), construct(args...) for an empty
+// optional, and destroy() for an engaged one.
+template<typename T,
+         bool = Has_niche<T>(),
+         bool = Trivially_destructible<T>()>
+  struct optional_storage;
+
+// A T, which is the niche when the optional is empty.
+template<typename T, bool Trivial>
+  struct optional_storage<T, true, Trivial> {
+    constexpr optional_storage() : x(niche_traits<T>::empty_value()) { }
+
+    template<typename... Args>
+      constexpr explicit optional_storage(in_place_t, Args&&... args)
+        : x(std::forward<Args>(args)...)
+      { }
+
+    constexpr bool engaged() const { return !niche_traits<T>::is_empty(x); }
+
+    ESTD_CXX14_CONSTEXPR T& get() { return x; }
+    constexpr const T& get() const { return x; }
+
+    template<typename... Args>
+      ESTD_CXX14_CONSTEXPR void construct(Args&&... args) { x = T(std::forward<Args>(args)...); }
+
+    ESTD_CXX14_CONSTEXPR void destroy() { x = niche_traits<T>::empty_value(); }
+
+    T x;
+  };
+
+// A T in a union, with a flag. The union leaves T unconstructed when the optional is empty.
+template<typename T>
+  struct optional_storage<T, false, true> {
+    constexpr optional_storage() : none(), full(false) { }
+
+    template<typename... Args>
+      constexpr explicit optional_storage(in_place_t, Args&&... args)
+        : x(std::forward<Args>(args)...), full(true)
+      { }
+
+    constexpr bool engaged() const { return full; }
+
+    ESTD_CXX14_CONSTEXPR T& get() { return x; }
+    constexpr const T& get() const { return x; }
+
+    template<typename... Args>
+      void construct(Args&&... args)
+      {
+        ::new (static_cast<void*>(&x)) T(std::forward<Args>(args)...);
+        full = true;
+      }
+
+    ESTD_CXX14_CONSTEXPR void destroy() { full = false; }
+
+    union {
+      char none;
+      T x;
+    };
+    bool full;
+  };
+
+// As above, with a destructor for T.
+template<typename T>
+  struct optional_storage<T, false, false> {
+    constexpr optional_storage() : none(), full(false) { }
+
+    template<typename... Args>
+      constexpr explicit optional_storage(in_place_t, Args&&... args)
+        : x(std::forward<Args>(args)...), full(true)
+      { }
+
+    ~optional_storage()
+    {
+      if (full)
+        x.~T();
+    }
+
+    constexpr bool engaged() const { return full; }
+
+    T& get() { return x; }
+    constexpr const T& get() const { return x; }
+
+    template<typename... Args>
+      void construct(Args&&... args)
+      {
+        ::new (static_cast<void*>(&x)) T(std::forward<Args>(args)...);
+        full = true;
+      }
+
+    void destroy()
+    {
+      x.~T();
+      full = false;
+    }
+
+    union {
+      char none;
+      T x;
+    };
+    bool full;
+  };
+
+// The copy and move operations. A niche type, or a trivially copyable one, is copied with
+// the storage; otherwise the union needs them spelled out.
+template<typename T, bool = Has_niche<T>() || Trivially_copyable<T>()>
+  struct optional_base : optional_storage<T> {
+    using optional_storage<T>::optional_storage;
+  };
+
+template<typename T>
+  struct optional_base<T, false> : optional_storage<T> {
+    using optional_storage<T>::optional_storage;
+
+    optional_base() = default;
+
+    optional_base(const optional_base& o)
+      : optional_storage<T>()
+    {
+      if (o.engaged())
+        this->construct(o.get());
+    }
+
+    optional_base(optional_base&& o) noexcept(Nothrow_move_constructible<T>())
+      : optional_storage<T>()
+    {
+      if (o.engaged())
+        this->construct(std::move(o.get()));
+    }
+
+    optional_base& operator=(const optional_base& o)
+    {
+      assign(o.engaged(), o.get());
+      return *this;
+    }
+
+    optional_base& operator=(optional_base&& o)
+      noexcept(Nothrow_move_constructible<T>() && Nothrow_move_assignable<T>())
+    {
+      assign(o.engaged(), std::move(o.get()));
+      return *this;
+    }
+
+  private:
+    template<typename U>
+      void assign(bool engaged, U&& x)
+      {
+        if (this->engaged() && engaged)
+          this->get() = std::forward<U>(x);
+        else if (engaged)
+          this->construct(std::forward<U>(x));
+        else if (this->engaged())
+          this->destroy();
+      }
+  };
+
+}	// namespace impl
+
+template<typename T>
+  class optional : private impl::optional_base<T> {
+    static_assert(Object<T>() && !Array<T>(), "optional: T must be an object type and not an array");
+    static_assert(!Same<Remove_cv<T>, nullopt_t>() && !Same<Remove_cv<T>, in_place_t>(),
+                  "optional: T can't be nullopt_t or in_place_t");
+
+    using base = impl::optional_base<T>;
+
+  public:
+    using value_type = T;
+
+    constexpr optional() noexcept : base() { }
+    constexpr optional(nullopt_t) noexcept : base() { }
+
+    // From a T, or what converts to one, as optional<std::string> o = "text" does.
+    template<typename U = T,
+             typename = Enable_if<Convertible<U, T>()
+                               && !Same<Decay<U>, optional>()
+                               && !Same<Decay<U>, nullopt_t>()
+                               && !Same<Decay<U>, in_place_t>()>>
+      constexpr optional(U&& x) : base(in_place, std::forward<U>(x)) { }
+
+    template<typename... Args>
+      constexpr explicit optional(in_place_t, Args&&... args)
+        : base(in_place, std::forward<Args>(args)...)
+      { }
+
+    ESTD_CXX14_CONSTEXPR optional& operator=(nullopt_t) noexcept
+    {
+      reset();
+      return *this;
+    }
+
+    // Assigns a T, or what converts to one; optional = {} still empties the optional.
+    template<typename U,
+             typename = Enable_if<Convertible<U, T>() && !Same<Decay<U>, optional>() && !Same<Decay<U>, nullopt_t>()>>
+      ESTD_CXX14_CONSTEXPR optional& operator=(U&& x)
+      {
+        if (has_value())
+          this->get() = std::forward<U>(x);
+        else
+          this->construct(std::forward<U>(x));
+        return *this;
+      }
+
+    template<typename... Args>
+      ESTD_CXX14_CONSTEXPR T& emplace(Args&&... args)
+      {
+        reset();
+        this->construct(std::forward<Args>(args)...);
+        return this->get();
+      }
+
+    ESTD_CXX14_CONSTEXPR void reset() noexcept
+    {
+      if (has_value())
+        this->destroy();
+    }
+
+    ESTD_CXX14_CONSTEXPR void swap(optional& o)
+    {
+      using std::swap;
+      if (has_value() && o.has_value()) {
+        swap(**this, *o);
+      } else if (has_value()) {
+        o.construct(std::move(**this));
+        reset();
+      } else if (o.has_value()) {
+        this->construct(std::move(*o));
+        o.reset();
+      }
+    }
+
+    constexpr bool has_value() const noexcept { return this->engaged(); }
+    constexpr explicit operator bool() const noexcept { return this->engaged(); }
+
+    // The value. The optional must not be empty.
+    ESTD_CXX14_CONSTEXPR T& operator*() { return this->get(); }
+    constexpr const T& operator*() const { return this->get(); }
+
+    ESTD_CXX14_CONSTEXPR T* operator->() { return &this->get(); }
+    constexpr const T* operator->() const { return &this->get(); }
+
+    // The value, or bad_optional_access.
+    ESTD_CXX14_CONSTEXPR T& value()
+    {
+      if (!has_value())
+        throw bad_optional_access();
+      return this->get();
+    }
+
+    ESTD_CXX14_CONSTEXPR const T& value() const
+    {
+      if (!has_value())
+        throw bad_optional_access();
+      return this->get();
+    }
+
+    template<typename U>
+      constexpr T value_or(U&& x) const
+      {
+        return has_value() ? this->get() : static_cast<T>(std::forward<U>(x));
+      }
+
+    // Empty optionals are equal, and come before the others.
+
+    friend constexpr bool operator==(const optional& a, const optional& b)
+    {
+      return a.has_value() == b.has_value() && (!a.has_value() || *a == *b);
+    }
+
+    friend constexpr bool operator!=(const optional& a, const optional& b) { return !(a == b); }
+
+    friend constexpr bool operator<(const optional& a, const optional& b)
+    {
+      return b.has_value() && (!a.has_value() || *a < *b);
+    }
+
+    friend constexpr bool operator>(const optional& a, const optional& b) { return b < a; }
+    friend constexpr bool operator<=(const optional& a, const optional& b) { return !(b < a); }
+    friend constexpr bool operator>=(const optional& a, const optional& b) { return !(a < b); }
+
+    friend constexpr bool operator==(const optional& a, nullopt_t) { return !a.has_value(); }
+    friend constexpr bool operator==(nullopt_t, const optional& a) { return !a.has_value(); }
+    friend constexpr bool operator!=(const optional& a, nullopt_t) { return a.has_value(); }
+    friend constexpr bool operator!=(nullopt_t, const optional& a) { return a.has_value(); }
+
+    friend constexpr bool operator==(const optional& a, const T& x) { return a.has_value() && *a == x; }
+    friend constexpr bool operator==(const T& x, const optional& a) { return a.has_value() && *a == x; }
+    friend constexpr bool operator!=(const optional& a, const T& x) { return !(a == x); }
+    friend constexpr bool operator!=(const T& x, const optional& a) { return !(a == x); }
+  };
+
+template<typename T>
+  inline void swap(optional<T>& a, optional<T>& b) { a.swap(b); }
+
+template<typename T>
+  constexpr optional<Decay<T>> make_optional(T&& x)
+  {
+    return optional<Decay<T>>(std::forward<T>(x));
+  }
+
+}	// namespace Estd
+
+#endif	// OPTIONAL_H
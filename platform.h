@@ -0,0 +1,98 @@
+#ifndef PLATFORM_H
+#define PLATFORM_H
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Compiler and hardware facilities used by the containers and algorithms.
+// None of this takes part in the constraints checks. It only keeps the
+// compiler-specific spellings in one place, so the rest of the library can
+// stay portable.
+
+// constexpr for the functions that C++11 can't make constexpr: those that modify an object
+// or have more than a return statement. ESTD_HAS_CXX14_CONSTEXPR is defined when they are.
+#if defined(__cpp_constexpr) && __cpp_constexpr >= 201304L
+#define ESTD_HAS_CXX14_CONSTEXPR
+#define ESTD_CXX14_CONSTEXPR constexpr
+#else
+#define ESTD_CXX14_CONSTEXPR
+#endif
+
+// Placed before a loop, tells the compiler that no iteration reads memory that an earlier
+// one wrote, so it can vectorize the loop without checking its pointers for overlap.
+#if defined(__clang__)
+#define ESTD_IVDEP _Pragma("clang loop vectorize(assume_safety)")
+#elif defined(__GNUC__)
+#define ESTD_IVDEP _Pragma("GCC ivdep")
+#elif defined(_MSC_VER)
+#define ESTD_IVDEP __pragma(loop(ivdep))
+#else
+#define ESTD_IVDEP
+#endif
+
+namespace Estd {
+
+// The size of a cache line. 64 bytes is right for x86-64 and most ARM cores.
+// C++17 spells this std::hardware_destructive_interference_size, but we can't rely on it.
+constexpr std::size_t cache_line_size = 64;
+
+namespace impl {
+
+// Hint that the cache line holding p will be read soon.
+// A prefetch never faults, so p does not have to point into a live object.
+inline void prefetch(const void* p)
+{
+#if defined(__GNUC__)
+  __builtin_prefetch(p);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+  _mm_prefetch(static_cast<const char*>(p), _MM_HINT_T0);
+#else
+  (void)p;
+#endif
+}
+
+// The number of trailing zero bits in x. x must not be zero.
+inline unsigned countr_zero(std::uint64_t x)
+{
+#if defined(__GNUC__)
+  return static_cast<unsigned>(__builtin_ctzll(x));
+#elif defined(_MSC_VER) && defined(_M_X64)
+  unsigned long i;
+  _BitScanForward64(&i, x);
+  return static_cast<unsigned>(i);
+#else
+  unsigned n = 0;
+  while (!(x & 1)) {
+    x >>= 1;
+    ++n;
+  }
+  return n;
+#endif
+}
+
+// The number of set bits in x. With GCC and Clang this is one popcnt instruction when the
+// target has it (-mpopcnt, or any -march from Nehalem on), and a table-free bit-twiddling
+// sequence otherwise.
+inline unsigned popcount(std::uint64_t x)
+{
+#if defined(__GNUC__)
+  return static_cast<unsigned>(__builtin_popcountll(x));
+#elif defined(_MSC_VER) && defined(_M_X64)
+  return static_cast<unsigned>(__popcnt64(x));
+#else
+  x = x - ((x >> 1) & 0x5555555555555555u);
+  x = (x & 0x3333333333333333u) + ((x >> 2) & 0x3333333333333333u);
+  x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0fu;
+  return static_cast<unsigned>((x * 0x0101010101010101u) >> 56);
+#endif
+}
+
+}	// namespace impl
+
+}	// namespace Estd
+
+#endif	// PLATFORM_H
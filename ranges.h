@@ -0,0 +1,1098 @@
+#ifndef RANGES_H
+#define RANGES_H
+
+#include "constraints.h"
+#include "iterator_facade.h"
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <utility>
+
+// Lazy range adaptors.
+//
+// Each view::X(r, ...) returns a view of r that computes its elements as it is traversed.
+// Views are Ranges, so they nest: a pipeline like
+//
+//   for (auto x : view::take(view::filter(view::transform(v, f), p), 10))
+//
+// builds no intermediate containers. Its iterators are small structs wrapping v's iterator,
+// every operation on them is inline, and the whole pipeline compiles to one loop over v.
+//
+// A view keeps the strongest iterator category its base allows: transforming or striding a
+// random access range gives a random access range, and so does concatenating two of them.
+// Filtering never gives more than bidirectional iterators, and taking a prefix of a range
+// that is not random access gives forward iterators.
+//
+// The views are built on Bounded_ranges, whose end is an iterator.
+//
+// An lvalue range is held by reference and must outlive the view. An rvalue range, such as
+// another view, is moved into the view. The iterators of a view that calls a function refer to
+// the function stored in the view, so they are invalidated when the view is moved.
+//
+// Functions and predicates are called as Result_of describes, so pointers to members
+// can be used: view::transform(people, &person::name).
+
+namespace Estd {
+
+namespace impl {
+
+// The type through which a view uses its base: a reference to an lvalue range, and a const
+// reference to a range the view owns, so that begin() and end() can be const.
+template<typename R>
+  using View_base = Conditional<Lvalue_reference<R>(), R, const R&>;
+
+template<typename R>
+  using View_iterator = Begin_result<View_base<R>>;
+
+// The weaker of an iterator category and a cap.
+template<typename C, typename Cap>
+  using Category_at_most = Conditional<Derived<C, Cap>(), Cap, C>;
+
+// The strongest category that two iterator categories share.
+template<typename C1, typename C2>
+  using Common_category = Conditional<Derived<C1, C2>(), C2, C1>;
+
+template<typename R>
+  constexpr bool Random_access_range()
+  {
+    return Random_access_iterator<View_iterator<R>>();
+  }
+
+template<typename R>
+  auto range_begin(R&& r) -> decltype(std::begin(r))
+  {
+    return std::begin(r);
+  }
+
+template<typename R>
+  auto range_end(R&& r) -> decltype(std::end(r))
+  {
+    return std::end(r);
+  }
+
+}	// namespace impl
+
+// Sentinels
+
+// The end of a sequence terminated by a value-initialized element, such as a C string.
+// An iterator is equal to null_sentinel when it refers to the terminator.
+struct null_sentinel { };
+
+template<typename I>
+  auto operator==(const I& i, null_sentinel) -> Enable_if<Input_iterator<I>(), bool>
+  {
+    return *i == Value_type<I>();
+  }
+
+template<typename I>
+  auto operator==(null_sentinel, const I& i) -> Enable_if<Input_iterator<I>(), bool>
+  {
+    return *i == Value_type<I>();
+  }
+
+template<typename I>
+  auto operator!=(const I& i, null_sentinel) -> Enable_if<Input_iterator<I>(), bool>
+  {
+    return !(*i == Value_type<I>());
+  }
+
+template<typename I>
+  auto operator!=(null_sentinel, const I& i) -> Enable_if<Input_iterator<I>(), bool>
+  {
+    return !(*i == Value_type<I>());
+  }
+
+// The end of a sequence that doesn't end, or whose end is known to be found by other means,
+// e.g. a search for a value known to be present. Comparisons are constant, so the end test
+// compiles away.
+struct unreachable_sentinel { };
+
+template<typename I>
+  constexpr auto operator==(const I&, unreachable_sentinel) -> Enable_if<Iterator<I>(), bool> { return false; }
+
+template<typename I>
+  constexpr auto operator==(unreachable_sentinel, const I&) -> Enable_if<Iterator<I>(), bool> { return false; }
+
+template<typename I>
+  constexpr auto operator!=(const I&, unreachable_sentinel) -> Enable_if<Iterator<I>(), bool> { return true; }
+
+template<typename I>
+  constexpr auto operator!=(unreachable_sentinel, const I&) -> Enable_if<Iterator<I>(), bool> { return true; }
+
+// subrange
+// An iterator and a sentinel, as a Range.
+
+template<typename I, typename S = I>
+  class subrange {
+    static_assert(Sentinel_for<S, I>(), "subrange: S must be a sentinel for I");
+
+  public:
+    using iterator = I;
+    using sentinel = S;
+    using value_type = Value_type<I>;
+    using difference_type = Difference_type<I>;
+
+    subrange() = default;
+
+    subrange(I first, S last)
+      : first(first), last(last)
+    { }
+
+    I begin() const { return first; }
+    S end() const { return last; }
+
+    bool empty() const { return first == last; }
+
+  private:
+    I first;
+    S last;
+  };
+
+// The characters of a null-terminated string, without the terminator.
+// Traversing it does not call strlen first.
+template<typename C>
+  subrange<const C*, null_sentinel> cstring(const C* s)
+  {
+    return {s, null_sentinel{}};
+  }
+
+// The sequence starting at first with no end.
+template<typename I>
+  subrange<I, unreachable_sentinel> unbounded(I first)
+  {
+    return {first, unreachable_sentinel{}};
+  }
+
+// transform_view
+// The elements are f(x) for each x in the base.
+
+template<typename R, typename F>
+  class transform_view {
+    using base_iterator = impl::View_iterator<R>;
+    using result = Result_of<const F&(Dereference_result<base_iterator>)>;
+
+  public:
+    class iterator
+      : public iterator_facade<iterator,
+                               Remove_cv<Remove_reference<result>>,
+                               result,
+                               Iterator_category<base_iterator>,
+                               Difference_type<base_iterator>>
+    {
+      using facade = iterator_facade<iterator,
+                                     Remove_cv<Remove_reference<result>>,
+                                     result,
+                                     Iterator_category<base_iterator>,
+                                     Difference_type<base_iterator>>;
+      friend facade;
+
+    public:
+      iterator() : it(), f(nullptr) { }
+
+      iterator(base_iterator i, const F* f) : it(i), f(f) { }
+
+      base_iterator base() const { return it; }
+
+    private:
+      using D = Difference_type<base_iterator>;
+
+      result dereference() const { return impl::invoke::fn(*f, *it); }
+      bool equal(const iterator& x) const { return it == x.it; }
+      void increment() { ++it; }
+      void decrement() { --it; }
+      void advance(D n) { it += n; }
+      D distance_to(const iterator& x) const { return x.it - it; }
+
+      base_iterator it;
+      const F* f;
+    };
+
+    transform_view(R&& r, F f)
+      : r(std::forward<R>(r)), f(std::move(f))
+    { }
+
+    iterator begin() const { return iterator(impl::range_begin(base()), &f); }
+    iterator end() const { return iterator(impl::range_end(base()), &f); }
+
+  private:
+    impl::View_base<R> base() const { return r; }
+
+    R r;
+    F f;
+  };
+
+// filter_view
+// The elements of the base that satisfy a predicate.
+// begin() has to find the first such element, so it is linear, not constant, time.
+
+template<typename R, typename P>
+  class filter_view {
+    using base_iterator = impl::View_iterator<R>;
+    using category = impl::Category_at_most<Iterator_category<base_iterator>, std::bidirectional_iterator_tag>;
+
+  public:
+    class iterator
+      : public iterator_facade<iterator,
+                               Value_type<base_iterator>,
+                               Dereference_result<base_iterator>,
+                               category,
+                               Difference_type<base_iterator>>
+    {
+      using facade = iterator_facade<iterator,
+                                     Value_type<base_iterator>,
+                                     Dereference_result<base_iterator>,
+                                     category,
+                                     Difference_type<base_iterator>>;
+      friend facade;
+
+    public:
+      iterator() : it(), last(), p(nullptr) { }
+
+      iterator(base_iterator i, base_iterator last, const P* p)
+        : it(i), last(last), p(p)
+      {
+        satisfy();
+      }
+
+      base_iterator base() const { return it; }
+
+    private:
+      Dereference_result<base_iterator> dereference() const { return *it; }
+      bool equal(const iterator& x) const { return it == x.it; }
+
+      void increment()
+      {
+        ++it;
+        satisfy();
+      }
+
+      // There must be a satisfying element before this one.
+      void decrement()
+      {
+        do
+          --it;
+        while (!impl::invoke::fn(*p, *it));
+      }
+
+      void satisfy()
+      {
+        while (it != last && !impl::invoke::fn(*p, *it))
+          ++it;
+      }
+
+      base_iterator it;
+      base_iterator last;
+      const P* p;
+    };
+
+    filter_view(R&& r, P p)
+      : r(std::forward<R>(r)), p(std::move(p))
+    { }
+
+    iterator begin() const { return iterator(impl::range_begin(base()), impl::range_end(base()), &p); }
+    iterator end() const { return iterator(impl::range_end(base()), impl::range_end(base()), &p); }
+
+  private:
+    impl::View_base<R> base() const { return r; }
+
+    R r;
+    P p;
+  };
+
+// take_view
+// The first n elements of the base, or all of them if there are fewer.
+// Over a random access range, the iterators are those of the base. Otherwise, an iterator
+// counts the elements left to take, and compares equal to end() when either the count or
+// the base runs out.
+
+template<typename R, bool = impl::Random_access_range<R>()>
+  class take_view;
+
+template<typename R>
+  class take_view<R, true> {
+    using base_iterator = impl::View_iterator<R>;
+    using D = Difference_type<base_iterator>;
+
+  public:
+    using iterator = base_iterator;
+
+    take_view(R&& r, D n)
+      : r(std::forward<R>(r)), n(n)
+    { }
+
+    iterator begin() const { return impl::range_begin(base()); }
+
+    iterator end() const
+    {
+      iterator first = begin();
+      D size = impl::range_end(base()) - first;
+      return first + (n < size ? n : size);
+    }
+
+  private:
+    impl::View_base<R> base() const { return r; }
+
+    R r;
+    D n;
+  };
+
+template<typename R>
+  class take_view<R, false> {
+    using base_iterator = impl::View_iterator<R>;
+    using category = impl::Category_at_most<Iterator_category<base_iterator>, std::forward_iterator_tag>;
+    using D = Difference_type<base_iterator>;
+
+  public:
+    class iterator
+      : public iterator_facade<iterator,
+                               Value_type<base_iterator>,
+                               Dereference_result<base_iterator>,
+                               category,
+                               D>
+    {
+      using facade = iterator_facade<iterator,
+                                     Value_type<base_iterator>,
+                                     Dereference_result<base_iterator>,
+                                     category,
+                                     D>;
+      friend facade;
+
+    public:
+      iterator() : it(), count() { }
+
+      iterator(base_iterator i, D n) : it(i), count(n) { }
+
+      base_iterator base() const { return it; }
+
+    private:
+      Dereference_result<base_iterator> dereference() const { return *it; }
+      bool equal(const iterator& x) const { return count == x.count || it == x.it; }
+
+      void increment()
+      {
+        ++it;
+        --count;
+      }
+
+      base_iterator it;
+      D count;
+    };
+
+    take_view(R&& r, D n)
+      : r(std::forward<R>(r)), n(n)
+    { }
+
+    iterator begin() const { return iterator(impl::range_begin(base()), n); }
+    iterator end() const { return iterator(impl::range_end(base()), 0); }
+
+  private:
+    impl::View_base<R> base() const { return r; }
+
+    R r;
+    D n;
+  };
+
+// drop_view
+// The elements of the base after the first n, or none if there are fewer.
+// The iterators are those of the base. begin() is constant time for random access ranges
+// and linear otherwise.
+
+template<typename R>
+  class drop_view {
+    using base_iterator = impl::View_iterator<R>;
+    using D = Difference_type<base_iterator>;
+
+  public:
+    using iterator = base_iterator;
+
+    drop_view(R&& r, D n)
+      : r(std::forward<R>(r)), n(n)
+    { }
+
+    iterator begin() const
+    {
+      return skip(impl::range_begin(base()), impl::range_end(base()), boolean_constant<impl::Random_access_range<R>()>{});
+    }
+
+    iterator end() const { return impl::range_end(base()); }
+
+  private:
+    impl::View_base<R> base() const { return r; }
+
+    iterator skip(iterator first, iterator last, boolean_constant<true>) const
+    {
+      D size = last - first;
+      return first + (n < size ? n : size);
+    }
+
+    iterator skip(iterator first, iterator last, boolean_constant<false>) const
+    {
+      for (D i = 0; i != n && first != last; ++i)
+        ++first;
+      return first;
+    }
+
+    R r;
+    D n;
+  };
+
+// stride_view
+// Every nth element of the base, starting with the first.
+// Over a random access range, an iterator is the base's begin() and an offset into it, so
+// that no iterator is ever moved past the end of the base. Otherwise, an iterator stops at
+// the end of the base and remembers how many steps it missed, so that it can be decremented.
+
+template<typename R, bool = impl::Random_access_range<R>()>
+  class stride_view;
+
+template<typename R>
+  class stride_view<R, true> {
+    using base_iterator = impl::View_iterator<R>;
+    using D = Difference_type<base_iterator>;
+
+  public:
+    class iterator
+      : public iterator_facade<iterator,
+                               Value_type<base_iterator>,
+                               Dereference_result<base_iterator>,
+                               Iterator_category<base_iterator>,
+                               D>
+    {
+      using facade = iterator_facade<iterator,
+                                     Value_type<base_iterator>,
+                                     Dereference_result<base_iterator>,
+                                     Iterator_category<base_iterator>,
+                                     D>;
+      friend facade;
+
+    public:
+      iterator() : first(), pos(), step(1) { }
+
+      iterator(base_iterator first, D pos, D step) : first(first), pos(pos), step(step) { }
+
+      base_iterator base() const { return first + pos; }
+
+    private:
+      Dereference_result<base_iterator> dereference() const { return first[pos]; }
+      bool equal(const iterator& x) const { return pos == x.pos; }
+      void increment() { pos += step; }
+      void decrement() { pos -= step; }
+      void advance(D n) { pos += n * step; }
+      D distance_to(const iterator& x) const { return (x.pos - pos) / step; }
+
+      base_iterator first;
+      D pos;
+      D step;
+    };
+
+    stride_view(R&& r, D step)
+      : r(std::forward<R>(r)), step(step)
+    { }
+
+    iterator begin() const { return iterator(impl::range_begin(base()), 0, step); }
+
+    // The end is the first multiple of step at or past the size of the base.
+    iterator end() const
+    {
+      base_iterator first = impl::range_begin(base());
+      D size = impl::range_end(base()) - first;
+      return iterator(first, (size + step - 1) / step * step, step);
+    }
+
+  private:
+    impl::View_base<R> base() const { return r; }
+
+    R r;
+    D step;
+  };
+
+template<typename R>
+  class stride_view<R, false> {
+    using base_iterator = impl::View_iterator<R>;
+    using category = impl::Category_at_most<Iterator_category<base_iterator>, std::bidirectional_iterator_tag>;
+    using D = Difference_type<base_iterator>;
+
+  public:
+    class iterator
+      : public iterator_facade<iterator,
+                               Value_type<base_iterator>,
+                               Dereference_result<base_iterator>,
+                               category,
+                               D>
+    {
+      using facade = iterator_facade<iterator,
+                                     Value_type<base_iterator>,
+                                     Dereference_result<base_iterator>,
+                                     category,
+                                     D>;
+      friend facade;
+
+    public:
+      iterator() : it(), last(), step(1), missing() { }
+
+      iterator(base_iterator i, base_iterator last, D step, D missing)
+        : it(i), last(last), step(step), missing(missing)
+      { }
+
+      base_iterator base() const { return it; }
+
+    private:
+      Dereference_result<base_iterator> dereference() const { return *it; }
+      bool equal(const iterator& x) const { return it == x.it; }
+
+      void increment()
+      {
+        for (missing = step; missing != 0 && it != last; --missing)
+          ++it;
+      }
+
+      void decrement()
+      {
+        for (D n = step - missing; n != 0; --n)
+          --it;
+        missing = 0;
+      }
+
+      base_iterator it;
+      base_iterator last;
+      D step;
+      D missing;
+    };
+
+    stride_view(R&& r, D step)
+      : r(std::forward<R>(r)), step(step)
+    { }
+
+    iterator begin() const
+    {
+      return iterator(impl::range_begin(base()), impl::range_end(base()), step, 0);
+    }
+
+    // Decrementing end() must land on the last element, so a bidirectional view has to
+    // find out how many steps the last increment misses.
+    iterator end() const
+    {
+      return end(boolean_constant<Derived<category, std::bidirectional_iterator_tag>()>{});
+    }
+
+  private:
+    impl::View_base<R> base() const { return r; }
+
+    iterator end(boolean_constant<false>) const
+    {
+      return iterator(impl::range_end(base()), impl::range_end(base()), step, 0);
+    }
+
+    iterator end(boolean_constant<true>) const
+    {
+      D size = 0;
+      for (base_iterator i = impl::range_begin(base()), e = impl::range_end(base()); i != e; ++i)
+        ++size;
+      D missing = size % step == 0 ? 0 : step - size % step;
+      return iterator(impl::range_end(base()), impl::range_end(base()), step, missing);
+    }
+
+    R r;
+    D step;
+  };
+
+// concat_view
+// The elements of one range followed by those of another.
+// If both ranges yield the same reference type, so does the view; otherwise it yields values
+// of the common type.
+
+template<typename R1, typename R2,
+         bool = impl::Random_access_range<R1>() && impl::Random_access_range<R2>()>
+  class concat_view;
+
+namespace impl {
+
+template<typename I1, typename I2>
+  using Concat_reference = Conditional<Same<Dereference_result<I1>, Dereference_result<I2>>(),
+                                       Dereference_result<I1>,
+                                       Common_type<Value_type<I1>, Value_type<I2>>>;
+
+template<typename I1, typename I2>
+  using Concat_difference = Common_type<Difference_type<I1>, Difference_type<I2>>;
+
+// The type of view::concat(r1, r2, rs...).
+template<typename R1, typename R2, typename... Rs>
+  struct concat_result {
+    using type = concat_view<R1, typename concat_result<R2, Rs...>::type>;
+  };
+
+template<typename R1, typename R2>
+  struct concat_result<R1, R2> {
+    using type = concat_view<R1, R2>;
+  };
+
+}	// namespace impl
+
+template<typename R1, typename R2>
+  class concat_view<R1, R2, true> {
+    using first_iterator = impl::View_iterator<R1>;
+    using second_iterator = impl::View_iterator<R2>;
+    using reference = impl::Concat_reference<first_iterator, second_iterator>;
+    using D = impl::Concat_difference<first_iterator, second_iterator>;
+
+  public:
+    class iterator
+      : public iterator_facade<iterator,
+                               Remove_cv<Remove_reference<reference>>,
+                               reference,
+                               std::random_access_iterator_tag,
+                               D>
+    {
+      using facade = iterator_facade<iterator,
+                                     Remove_cv<Remove_reference<reference>>,
+                                     reference,
+                                     std::random_access_iterator_tag,
+                                     D>;
+      friend facade;
+
+    public:
+      iterator() : first1(), first2(), size1(), pos() { }
+
+      iterator(first_iterator first1, second_iterator first2, D size1, D pos)
+        : first1(first1), first2(first2), size1(size1), pos(pos)
+      { }
+
+    private:
+      reference dereference() const { return pos < size1 ? first1[pos] : first2[pos - size1]; }
+      bool equal(const iterator& x) const { return pos == x.pos; }
+      void increment() { ++pos; }
+      void decrement() { --pos; }
+      void advance(D n) { pos += n; }
+      D distance_to(const iterator& x) const { return x.pos - pos; }
+
+      first_iterator first1;
+      second_iterator first2;
+      D size1;
+      D pos;
+    };
+
+    concat_view(R1&& r1, R2&& r2)
+      : r1(std::forward<R1>(r1)), r2(std::forward<R2>(r2))
+    { }
+
+    iterator begin() const
+    {
+      return iterator(impl::range_begin(first()), impl::range_begin(second()), size1(), 0);
+    }
+
+    iterator end() const
+    {
+      D size2 = impl::range_end(second()) - impl::range_begin(second());
+      return iterator(impl::range_begin(first()), impl::range_begin(second()), size1(), size1() + size2);
+    }
+
+  private:
+    impl::View_base<R1> first() const { return r1; }
+    impl::View_base<R2> second() const { return r2; }
+
+    D size1() const { return impl::range_end(first()) - impl::range_begin(first()); }
+
+    R1 r1;
+    R2 r2;
+  };
+
+template<typename R1, typename R2>
+  class concat_view<R1, R2, false> {
+    using first_iterator = impl::View_iterator<R1>;
+    using second_iterator = impl::View_iterator<R2>;
+    using reference = impl::Concat_reference<first_iterator, second_iterator>;
+    using category = impl::Category_at_most<impl::Common_category<Iterator_category<first_iterator>,
+                                                                  Iterator_category<second_iterator>>,
+                                            std::bidirectional_iterator_tag>;
+    using D = impl::Concat_difference<first_iterator, second_iterator>;
+
+  public:
+    class iterator
+      : public iterator_facade<iterator,
+                               Remove_cv<Remove_reference<reference>>,
+                               reference,
+                               category,
+                               D>
+    {
+      using facade = iterator_facade<iterator,
+                                     Remove_cv<Remove_reference<reference>>,
+                                     reference,
+                                     category,
+                                     D>;
+      friend facade;
+
+    public:
+      iterator() : it1(), last1(), first2(), it2() { }
+
+      iterator(first_iterator it1, first_iterator last1, second_iterator first2, second_iterator it2)
+        : it1(it1), last1(last1), first2(first2), it2(it2)
+      { }
+
+    private:
+      reference dereference() const
+      {
+        if (it1 != last1)
+          return *it1;
+        return *it2;
+      }
+
+      bool equal(const iterator& x) const { return it1 == x.it1 && it2 == x.it2; }
+
+      void increment()
+      {
+        if (it1 != last1)
+          ++it1;
+        else
+          ++it2;
+      }
+
+      void decrement()
+      {
+        if (it2 != first2)
+          --it2;
+        else
+          --it1;
+      }
+
+      first_iterator it1;
+      first_iterator last1;
+      second_iterator first2;
+      second_iterator it2;
+    };
+
+    concat_view(R1&& r1, R2&& r2)
+      : r1(std::forward<R1>(r1)), r2(std::forward<R2>(r2))
+    { }
+
+    iterator begin() const
+    {
+      return iterator(impl::range_begin(first()), impl::range_end(first()),
+                      impl::range_begin(second()), impl::range_begin(second()));
+    }
+
+    iterator end() const
+    {
+      return iterator(impl::range_end(first()), impl::range_end(first()),
+                      impl::range_begin(second()), impl::range_end(second()));
+    }
+
+  private:
+    impl::View_base<R1> first() const { return r1; }
+    impl::View_base<R2> second() const { return r2; }
+
+    R1 r1;
+    R2 r2;
+  };
+
+// zip_view
+// The elements are tuples of the elements of several ranges at the same position, as many
+// as the shortest range has. Dereferencing yields a tuple of the ranges' references, so
+// assigning a tuple to *i writes through to every range.
+//
+// Over random access ranges, the iterators are random access and advance all the underlying
+// iterators in step, but only compare the first. A loop over a zip of arrays then has a
+// trip count the compiler can see, and vectorizes like the index loop it replaces.
+// Otherwise the iterators are at most forward, and compare equal when any of the underlying
+// iterators do, so that iteration stops at the end of the shortest range.
+
+namespace impl {
+
+template<typename C1, typename C2>
+  struct common_category {
+    using type = Common_category<C1, C2>;
+  };
+
+}	// namespace impl
+
+template<typename... Rs>
+  class zip_view {
+    static_assert(sizeof...(Rs) > 0, "zip_view: requires at least one range");
+
+    using iterators = std::tuple<impl::View_iterator<Rs>...>;
+    using indices = index_sequence_for<Rs...>;
+    using D = Common_type<Difference_type<impl::View_iterator<Rs>>...>;
+
+    static constexpr bool random_access = impl::all_of<impl::Random_access_range<Rs>()...>();
+
+    using category = Conditional<random_access,
+                                 std::random_access_iterator_tag,
+                                 impl::Category_at_most<Fold<impl::common_category, type_list<Iterator_category<impl::View_iterator<Rs>>...>>,
+                                                        std::forward_iterator_tag>>;
+
+  public:
+    class iterator
+      : public iterator_facade<iterator,
+                               std::tuple<Value_type<impl::View_iterator<Rs>>...>,
+                               std::tuple<Dereference_result<impl::View_iterator<Rs>>...>,
+                               category,
+                               D>
+    {
+      using facade = iterator_facade<iterator,
+                                     std::tuple<Value_type<impl::View_iterator<Rs>>...>,
+                                     std::tuple<Dereference_result<impl::View_iterator<Rs>>...>,
+                                     category,
+                                     D>;
+      friend facade;
+
+    public:
+      iterator() : its() { }
+
+      explicit iterator(iterators its) : its(its) { }
+
+      const iterators& base() const { return its; }
+
+    private:
+      typename facade::reference dereference() const { return dereference(indices{}); }
+
+      template<std::size_t... N>
+        typename facade::reference dereference(index_sequence<N...>) const
+        {
+          return typename facade::reference(*std::get<N>(its)...);
+        }
+
+      bool equal(const iterator& x) const { return equal(x, boolean_constant<random_access>{}, indices{}); }
+
+      template<std::size_t... N>
+        bool equal(const iterator& x, boolean_constant<true>, index_sequence<N...>) const
+        {
+          return std::get<0>(its) == std::get<0>(x.its);
+        }
+
+      template<std::size_t... N>
+        bool equal(const iterator& x, boolean_constant<false>, index_sequence<N...>) const
+        {
+          return !impl::All(!(std::get<N>(its) == std::get<N>(x.its))...);
+        }
+
+      void increment() { increment(indices{}); }
+
+      template<std::size_t... N>
+        void increment(index_sequence<N...>) { impl::expand(++std::get<N>(its)...); }
+
+      void decrement() { decrement(indices{}); }
+
+      template<std::size_t... N>
+        void decrement(index_sequence<N...>) { impl::expand(--std::get<N>(its)...); }
+
+      void advance(D n) { advance(n, indices{}); }
+
+      template<std::size_t... N>
+        void advance(D n, index_sequence<N...>) { impl::expand(std::get<N>(its) += n...); }
+
+      D distance_to(const iterator& x) const { return std::get<0>(x.its) - std::get<0>(its); }
+
+      iterators its;
+    };
+
+    explicit zip_view(Rs&&... rs)
+      : rs(std::forward<Rs>(rs)...)
+    { }
+
+    iterator begin() const { return begin(indices{}); }
+
+    iterator end() const { return end(boolean_constant<random_access>{}, indices{}); }
+
+  private:
+    template<std::size_t... N>
+      iterator begin(index_sequence<N...>) const
+      {
+        return iterator(iterators(impl::range_begin(std::get<N>(rs))...));
+      }
+
+    // The shortest size, so that every iterator stops inside its own range.
+    template<std::size_t... N>
+      iterator end(boolean_constant<true>, index_sequence<N...>) const
+      {
+        D sizes[] = { static_cast<D>(impl::range_end(std::get<N>(rs)) - impl::range_begin(std::get<N>(rs)))... };
+        D n = sizes[0];
+        for (D size : sizes)
+          n = size < n ? size : n;
+        return begin() + n;
+      }
+
+    template<std::size_t... N>
+      iterator end(boolean_constant<false>, index_sequence<N...>) const
+      {
+        return iterator(iterators(impl::range_end(std::get<N>(rs))...));
+      }
+
+    std::tuple<Rs...> rs;
+  };
+
+// enumerate_view
+// The elements are tuples of an index and an element of the base:
+//
+//   for (auto x : view::enumerate(v))
+//     use(std::get<0>(x), std::get<1>(x));
+//
+// The iterators have the category of the base. end() knows its index, so that it can be
+// decremented, which for a bidirectional range means counting the elements.
+
+template<typename R>
+  class enumerate_view {
+    using base_iterator = impl::View_iterator<R>;
+    using D = Difference_type<base_iterator>;
+
+  public:
+    class iterator
+      : public iterator_facade<iterator,
+                               std::tuple<D, Value_type<base_iterator>>,
+                               std::tuple<D, Dereference_result<base_iterator>>,
+                               Iterator_category<base_iterator>,
+                               D>
+    {
+      using facade = iterator_facade<iterator,
+                                     std::tuple<D, Value_type<base_iterator>>,
+                                     std::tuple<D, Dereference_result<base_iterator>>,
+                                     Iterator_category<base_iterator>,
+                                     D>;
+      friend facade;
+
+    public:
+      iterator() : i(), it() { }
+
+      iterator(D i, base_iterator it) : i(i), it(it) { }
+
+      D index() const { return i; }
+      base_iterator base() const { return it; }
+
+    private:
+      typename facade::reference dereference() const { return typename facade::reference(i, *it); }
+      bool equal(const iterator& x) const { return it == x.it; }
+
+      void increment()
+      {
+        ++i;
+        ++it;
+      }
+
+      void decrement()
+      {
+        --i;
+        --it;
+      }
+
+      void advance(D n)
+      {
+        i += n;
+        it += n;
+      }
+
+      D distance_to(const iterator& x) const { return x.i - i; }
+
+      D i;
+      base_iterator it;
+    };
+
+    explicit enumerate_view(R&& r)
+      : r(std::forward<R>(r))
+    { }
+
+    iterator begin() const { return iterator(0, impl::range_begin(base())); }
+
+    iterator end() const
+    {
+      return end(boolean_constant<Derived<Iterator_category<base_iterator>, std::bidirectional_iterator_tag>()>{});
+    }
+
+  private:
+    impl::View_base<R> base() const { return r; }
+
+    iterator end(boolean_constant<true>) const
+    {
+      return iterator(std::distance(impl::range_begin(base()), impl::range_end(base())), impl::range_end(base()));
+    }
+
+    iterator end(boolean_constant<false>) const
+    {
+      return iterator(0, impl::range_end(base()));
+    }
+
+    R r;
+  };
+
+// The view factories.
+
+namespace view {
+
+template<typename R, typename F>
+  transform_view<R, F> transform(R&& r, F f)
+  {
+    static_assert(Bounded_range<R>(), "transform: requires a Bounded_range");
+    static_assert(Has_call<const F&, Dereference_result<impl::View_iterator<R>>>(),
+                  "transform: the function cannot be called with the elements of the range");
+
+    return transform_view<R, F>(std::forward<R>(r), std::move(f));
+  }
+
+template<typename R, typename P>
+  filter_view<R, P> filter(R&& r, P p)
+  {
+    static_assert(Bounded_range<R>(), "filter: requires a Bounded_range");
+    static_assert(Predicate<const P&, Dereference_result<impl::View_iterator<R>>>(),
+                  "filter: requires a Predicate on the elements of the range");
+
+    return filter_view<R, P>(std::forward<R>(r), std::move(p));
+  }
+
+template<typename R>
+  take_view<R> take(R&& r, Difference_type<impl::View_iterator<R>> n)
+  {
+    static_assert(Bounded_range<R>(), "take: requires a Bounded_range");
+
+    return take_view<R>(std::forward<R>(r), n);
+  }
+
+template<typename R>
+  drop_view<R> drop(R&& r, Difference_type<impl::View_iterator<R>> n)
+  {
+    static_assert(Bounded_range<R>(), "drop: requires a Bounded_range");
+
+    return drop_view<R>(std::forward<R>(r), n);
+  }
+
+// The step must be positive.
+template<typename R>
+  stride_view<R> stride(R&& r, Difference_type<impl::View_iterator<R>> step)
+  {
+    static_assert(Bounded_range<R>(), "stride: requires a Bounded_range");
+
+    return stride_view<R>(std::forward<R>(r), step);
+  }
+
+template<typename R1, typename R2>
+  concat_view<R1, R2> concat(R1&& r1, R2&& r2)
+  {
+    static_assert(Bounded_range<R1>() && Bounded_range<R2>(), "concat: requires Bounded_ranges");
+
+    return concat_view<R1, R2>(std::forward<R1>(r1), std::forward<R2>(r2));
+  }
+
+// Three or more ranges nest to the right.
+template<typename R1, typename R2, typename R3, typename... Rs>
+  typename impl::concat_result<R1, R2, R3, Rs...>::type concat(R1&& r1, R2&& r2, R3&& r3, Rs&&... rs)
+  {
+    return concat(std::forward<R1>(r1), concat(std::forward<R2>(r2), std::forward<R3>(r3), std::forward<Rs>(rs)...));
+  }
+
+template<typename... Rs>
+  zip_view<Rs...> zip(Rs&&... rs)
+  {
+    static_assert(impl::all_of<Bounded_range<Rs>()...>(), "zip: requires Bounded_ranges");
+
+    return zip_view<Rs...>(std::forward<Rs>(rs)...);
+  }
+
+template<typename R>
+  enumerate_view<R> enumerate(R&& r)
+  {
+    static_assert(Bounded_range<R>(), "enumerate: requires a Bounded_range");
+
+    return enumerate_view<R>(std::forward<R>(r));
+  }
+
+}	// namespace view
+
+}	// namespace Estd
+
+#endif	// RANGES_H
@@ -0,0 +1,305 @@
+#ifndef SEARCH_INDEX_H
+#define SEARCH_INDEX_H
+
+#include "algorithm.h"
+#include "compare.h"
+#include "constraints.h"
+#include "memory.h"
+#include "platform.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <vector>
+
+namespace Estd {
+
+// static_index is an immutable set of keys that answers lower_bound queries.
+//
+// For Totally_ordered arithmetic keys, the keys are stored in Eytzinger (breadth-first) order:
+// the root of the implicit search tree is at position 1, and the children of position k are
+// at 2k and 2k + 1. A search walks down the tree, so every key it touches is at a predictable
+// position. We prefetch the cache line holding the descendants a few levels down while the
+// current level is being compared, which hides most of the memory latency that makes binary
+// search over a large sorted array so slow. The batched lookup goes further by interleaving
+// many searches, so that the misses of one search overlap the comparisons of the others.
+//
+// Every other key type gets a plain sorted array and std::lower_bound. Both layouts have
+// the same interface. When compare_3way compares the keys in one call, as it does strings,
+// contains() is a three-way binary search that stops at the first equal key.
+//
+// lower_bound() returns a pointer to the smallest key not less than x, or nullptr if there
+// is none. The pointer refers to the index's own storage, so it is only good for reading the
+// key; the position of the key in sorted order is not kept.
+
+template<typename T,
+         bool = Totally_ordered<T>() && Arithmetic<T>()>
+  class static_index;
+
+// Eytzinger layout.
+template<typename T>
+  class static_index<T, true> {
+  public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    static_index() : tree(1), n(0) { }
+
+    template<typename I,
+             typename = Enable_if<Input_iterator<I>()>>
+      static_index(I first, I last)
+      {
+        std::vector<T> sorted(first, last);
+        build(sorted);
+      }
+
+    template<typename R,
+             typename = Enable_if<Bounded_range<R>()>>
+      explicit static_index(const R& r)
+      {
+        using std::begin;
+        using std::end;
+        std::vector<T> sorted(begin(r), end(r));
+        build(sorted);
+      }
+
+    static_index(std::initializer_list<T> list)
+    {
+      std::vector<T> sorted(list);
+      build(sorted);
+    }
+
+    size_type size() const { return n; }
+
+    bool empty() const { return n == 0; }
+
+    const T* lower_bound(const T& x) const
+    {
+      const T* b = tree.data();
+      std::size_t k = 1;
+      while (k <= n) {
+        impl::prefetch(ahead(k));
+        k = 2 * k + (b[k] < x);
+      }
+      return found(k);
+    }
+
+    bool contains(const T& x) const
+    {
+      const T* p = lower_bound(x);
+      return p && !(x < *p);
+    }
+
+    // Batched lower_bound. Writes one result (a const T*) to out for each query in [first, last)
+    // and returns the end of the output.
+    template<typename I, typename O>
+      O lower_bound(I first, I last, O out) const
+      {
+        static_assert(Input_iterator<I>(), "static_index: queries must be an input range");
+        static_assert(Convertible<Value_type<I>, T>(), "static_index: query type must convert to the key type");
+
+        T x[batch];
+        std::size_t k[batch];
+        while (first != last) {
+          std::size_t m = 0;
+          for (; m != batch && first != last; ++m, ++first) {
+            x[m] = *first;
+            k[m] = 1;
+          }
+          search(x, k, m);
+          for (std::size_t i = 0; i != m; ++i, ++out)
+            *out = found(k[i]);
+        }
+        return out;
+      }
+
+    // Batched contains. Writes one bool to out for each query.
+    template<typename I, typename O>
+      O contains(I first, I last, O out) const
+      {
+        static_assert(Input_iterator<I>(), "static_index: queries must be an input range");
+        static_assert(Convertible<Value_type<I>, T>(), "static_index: query type must convert to the key type");
+
+        T x[batch];
+        std::size_t k[batch];
+        while (first != last) {
+          std::size_t m = 0;
+          for (; m != batch && first != last; ++m, ++first) {
+            x[m] = *first;
+            k[m] = 1;
+          }
+          search(x, k, m);
+          for (std::size_t i = 0; i != m; ++i, ++out) {
+            const T* p = found(k[i]);
+            *out = p && !(x[i] < *p);
+          }
+        }
+        return out;
+      }
+
+  private:
+    // The number of keys sharing a cache line. Prefetching the line at position k * per_line
+    // fetches the descendants of k that are log2(per_line) levels down.
+    static constexpr std::size_t per_line = sizeof(T) < cache_line_size ? cache_line_size / sizeof(T) : 1;
+
+    // The number of searches interleaved by the batched lookups.
+    static constexpr std::size_t batch = 16;
+
+    void build(std::vector<T>& sorted)
+    {
+      std::sort(sorted.begin(), sorted.end());
+      n = sorted.size();
+      tree.resize(n + 1);
+      std::size_t i = 0;
+      fill(sorted, i, 1);
+    }
+
+    // An in-order walk of the implicit tree visits the keys in sorted order.
+    void fill(const std::vector<T>& sorted, std::size_t& i, std::size_t k)
+    {
+      if (k <= n) {
+        fill(sorted, i, 2 * k);
+        tree[k] = sorted[i++];
+        fill(sorted, i, 2 * k + 1);
+      }
+    }
+
+    // Computed as an integer, since the address may be far outside the array.
+    const void* ahead(std::size_t k) const
+    {
+      return reinterpret_cast<const void*>(reinterpret_cast<std::uintptr_t>(tree.data()) + k * per_line * sizeof(T));
+    }
+
+    // Advance m searches one level at a time. Each search stops once it falls off the tree.
+    void search(const T* x, std::size_t* k, std::size_t m) const
+    {
+      const T* b = tree.data();
+      bool active = true;
+      while (active) {
+        active = false;
+        for (std::size_t i = 0; i != m; ++i) {
+          if (k[i] <= n) {
+            impl::prefetch(ahead(k[i]));
+            k[i] = 2 * k[i] + (b[k[i]] < x[i]);
+            active = true;
+          }
+        }
+      }
+    }
+
+    // A search ends at the first position past the tree. Each step right appended a 1 bit to k,
+    // so stripping the trailing 1s and the 0 before them gives the last node at which we went
+    // left, which is the lower bound. If we never went left, k becomes 0.
+    const T* found(std::size_t k) const
+    {
+      k >>= impl::countr_zero(~static_cast<std::uint64_t>(k)) + 1;
+      return k ? tree.data() + k : nullptr;
+    }
+
+    // tree[0] is unused. It keeps tree[1] and its descendants on the cache line boundaries
+    // that the prefetch distance assumes.
+    std::vector<T, aligned_allocator<T>> tree;
+    std::size_t n;
+  };
+
+// Sorted array layout.
+template<typename T>
+  class static_index<T, false> {
+    static_assert(Weakly_ordered<T>(), "static_index: keys must be ordered");
+
+  public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    static_index() { }
+
+    template<typename I,
+             typename = Enable_if<Input_iterator<I>()>>
+      static_index(I first, I last)
+        : keys(first, last)
+      {
+        Estd::sort(keys.begin(), keys.end());
+      }
+
+    template<typename R,
+             typename = Enable_if<Bounded_range<R>()>>
+      explicit static_index(const R& r)
+      {
+        using std::begin;
+        using std::end;
+        keys.assign(begin(r), end(r));
+        Estd::sort(keys.begin(), keys.end());
+      }
+
+    static_index(std::initializer_list<T> list)
+      : keys(list)
+    {
+      Estd::sort(keys.begin(), keys.end());
+    }
+
+    size_type size() const { return keys.size(); }
+
+    bool empty() const { return keys.empty(); }
+
+    const T* lower_bound(const T& x) const
+    {
+      auto i = std::lower_bound(keys.begin(), keys.end(), x);
+      return i == keys.end() ? nullptr : &*i;
+    }
+
+    bool contains(const T& x) const
+    {
+      return contains(x, boolean_constant<One_call_comparable<T>()>{});
+    }
+
+    template<typename I, typename O>
+      O lower_bound(I first, I last, O out) const
+      {
+        static_assert(Input_iterator<I>(), "static_index: queries must be an input range");
+
+        for (; first != last; ++first, ++out)
+          *out = lower_bound(*first);
+        return out;
+      }
+
+    template<typename I, typename O>
+      O contains(I first, I last, O out) const
+      {
+        static_assert(Input_iterator<I>(), "static_index: queries must be an input range");
+
+        for (; first != last; ++first, ++out)
+          *out = contains(*first);
+        return out;
+      }
+
+  private:
+    bool contains(const T& x, boolean_constant<false>) const
+    {
+      const T* p = lower_bound(x);
+      return p && !(x < *p);
+    }
+
+    bool contains(const T& x, boolean_constant<true>) const
+    {
+      std::size_t lo = 0;
+      std::size_t hi = keys.size();
+      while (lo != hi) {
+        std::size_t mid = lo + (hi - lo) / 2;
+        int c = compare_3way(x, keys[mid]);
+        if (c == 0)
+          return true;
+        if (c < 0)
+          hi = mid;
+        else
+          lo = mid + 1;
+      }
+      return false;
+    }
+
+    std::vector<T> keys;
+  };
+
+}	// namespace Estd
+
+#endif	// SEARCH_INDEX_H
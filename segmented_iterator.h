@@ -0,0 +1,183 @@
+#ifndef SEGMENTED_ITERATOR_H
+#define SEGMENTED_ITERATOR_H
+
+#include "constraints.h"
+#include "iterator_facade.h"
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <utility>
+
+// Segmented iterators for the standard containers.
+//
+// std::deque stores its elements in fixed-size blocks. Its iterator checks for the end of
+// a block on every increment; as a segmented iterator, each block is a plain array.
+// The deque's iterator is not part of the standard interface, so the traits are provided
+// for libstdc++ only; with another library, deque iterators are simply not segmented.
+//
+// bucket_iterator<C> walks an unordered container bucket by bucket, through the
+// local_iterators of the buckets, which are its segments.
+
+namespace Estd {
+
+#if defined(__GLIBCXX__)
+
+namespace impl {
+
+template<typename T, typename Ref, typename Ptr>
+  struct deque_segments {
+    using iterator = std::_Deque_iterator<T, Ref, Ptr>;
+    using segment_iterator = typename iterator::_Map_pointer;
+    using local_iterator = Ptr;
+
+    static segment_iterator segment(const iterator& i) { return i._M_node; }
+    static local_iterator local(const iterator& i) { return i._M_cur; }
+
+    static local_iterator begin(segment_iterator s) { return *s; }
+    static local_iterator end(segment_iterator s) { return *s + iterator::_S_buffer_size(); }
+
+    static iterator compose(segment_iterator s, local_iterator l)
+    {
+      return iterator(const_cast<T*>(l), s);
+    }
+  };
+
+}	// namespace impl
+
+template<typename T>
+  struct segmented_iterator_traits<std::_Deque_iterator<T, T&, T*>>
+    : impl::deque_segments<T, T&, T*> { };
+
+template<typename T>
+  struct segmented_iterator_traits<std::_Deque_iterator<T, const T&, const T*>>
+    : impl::deque_segments<T, const T&, const T*> { };
+
+#endif	// __GLIBCXX__
+
+// bucket_iterator
+// The elements of an unordered container, bucket by bucket. C may be const.
+// Every position but the end is an element; the end is the end of the last bucket.
+
+namespace impl {
+
+template<typename C>
+  using Bucket_local_iterator = decltype(std::declval<C&>().begin(std::size_t()));
+
+}	// namespace impl
+
+template<typename C>
+  class bucket_iterator
+    : public iterator_facade<bucket_iterator<C>,
+                             Value_type<impl::Bucket_local_iterator<C>>,
+                             Dereference_result<impl::Bucket_local_iterator<C>>,
+                             std::forward_iterator_tag,
+                             Difference_type<impl::Bucket_local_iterator<C>>>
+  {
+    using facade = iterator_facade<bucket_iterator<C>,
+                                   Value_type<impl::Bucket_local_iterator<C>>,
+                                   Dereference_result<impl::Bucket_local_iterator<C>>,
+                                   std::forward_iterator_tag,
+                                   Difference_type<impl::Bucket_local_iterator<C>>>;
+    friend facade;
+
+  public:
+    using local_iterator = impl::Bucket_local_iterator<C>;
+
+    bucket_iterator() : c(nullptr), n(), cur() { }
+
+    // The position cur in bucket n, or the start of the next nonempty bucket if cur is
+    // the end of bucket n.
+    bucket_iterator(C* c, std::size_t n, local_iterator cur)
+      : c(c), n(n), cur(cur)
+    {
+      settle();
+    }
+
+    C* container() const { return c; }
+    std::size_t bucket() const { return n; }
+    local_iterator local() const { return cur; }
+
+  private:
+    Dereference_result<local_iterator> dereference() const { return *cur; }
+    bool equal(const bucket_iterator& x) const { return n == x.n && cur == x.cur; }
+
+    void increment()
+    {
+      ++cur;
+      settle();
+    }
+
+    void settle()
+    {
+      while (cur == c->end(n) && n + 1 < c->bucket_count())
+        cur = c->begin(++n);
+    }
+
+    C* c;
+    std::size_t n;
+    local_iterator cur;
+  };
+
+// The elements of c, bucket by bucket, as a Range.
+template<typename C>
+  class bucket_view {
+  public:
+    using iterator = bucket_iterator<C>;
+
+    explicit bucket_view(C& c) : c(&c) { }
+
+    iterator begin() const { return iterator(c, 0, c->begin(0)); }
+
+    iterator end() const
+    {
+      std::size_t last = c->bucket_count() - 1;
+      return iterator(c, last, c->end(last));
+    }
+
+  private:
+    C* c;
+  };
+
+template<typename C>
+  bucket_view<C> buckets(C& c)
+  {
+    return bucket_view<C>(c);
+  }
+
+namespace impl {
+
+template<typename C>
+  struct bucket_segment {
+    C* c;
+    std::size_t n;
+
+    bucket_segment& operator++()
+    {
+      ++n;
+      return *this;
+    }
+
+    bool operator==(const bucket_segment& x) const { return n == x.n; }
+    bool operator!=(const bucket_segment& x) const { return n != x.n; }
+  };
+
+}	// namespace impl
+
+template<typename C>
+  struct segmented_iterator_traits<bucket_iterator<C>> {
+    using iterator = bucket_iterator<C>;
+    using segment_iterator = impl::bucket_segment<C>;
+    using local_iterator = typename iterator::local_iterator;
+
+    static segment_iterator segment(const iterator& i) { return {i.container(), i.bucket()}; }
+    static local_iterator local(const iterator& i) { return i.local(); }
+
+    static local_iterator begin(segment_iterator s) { return s.c->begin(s.n); }
+    static local_iterator end(segment_iterator s) { return s.c->end(s.n); }
+
+    static iterator compose(segment_iterator s, local_iterator l) { return iterator(s.c, s.n, l); }
+  };
+
+}	// namespace Estd
+
+#endif	// SEGMENTED_ITERATOR_H
@@ -0,0 +1,466 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include "constraints.h"
+#include "platform.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ESTD_SIMD_SSE2
+#include <immintrin.h>
+#endif
+
+// simd<T, N> is a value of N lanes of T, held in one vector register where the target has one
+// that fits, with the arithmetic operators applied lane by lane. Comparisons yield a
+// simd_mask<T, N>, with one bool per lane. The operator detectors see simd as they see T:
+// Plus_result<simd<float>> is simd<float>, and Less_result<simd<float>> is simd_mask<float>.
+// Code written against the operators, such as
+//
+//   template<typename V>
+//     V clamp_step(V x, V lo, V hi) { return select(x < lo, lo, min(x * 2, hi)); }
+//
+// works on float and on simd<float> alike, and the simd version runs N lanes at once.
+// select, min and max have scalar overloads here for that purpose.
+//
+// The backend is chosen at compile time from the target, like the rest of the library's
+// hardware support (see impl/simd_x86.h):
+//   - AVX-512F: 16 floats, 8 doubles or 16 int32s per register, with k-register masks;
+//   - AVX: 8 floats or 4 doubles, and with AVX2, 8 int32s;
+//   - SSE2: 4 floats, 2 doubles or 4 int32s;
+//   - otherwise, and for the other element types, an array of N values, which the compiler
+//     may still vectorize.
+// simd<T> has the widest native width for T. Any other N works too, through the array
+// backend unless it matches a register.
+//
+// load and store take unaligned pointers, or a Contiguous_range and an offset; load_n and
+// store_n move the first n lanes, for the tail of an array. simd objects on the heap need
+// C++17 aligned new when the register is wider than 16 bytes.
+
+namespace Estd {
+
+// The number of lanes of T in the widest vector register of the target.
+template<typename T>
+  constexpr std::size_t simd_width()
+  {
+#if defined(__AVX512F__)
+    return 64 / sizeof(T);
+#elif defined(__AVX2__)
+    return 32 / sizeof(T);
+#elif defined(__AVX__)
+    return (Floating_point<T>() ? 32 : 16) / sizeof(T);
+#else
+    return 16 / sizeof(T) ? 16 / sizeof(T) : 1;
+#endif
+  }
+
+template<typename T, std::size_t N = simd_width<T>()>
+  class simd;
+
+template<typename T, std::size_t N = simd_width<T>()>
+  class simd_mask;
+
+namespace impl {
+
+// The array backend. Each operation is a loop over the lanes.
+
+template<typename T, std::size_t N>
+  struct simd_lanes {
+    T v[N];
+  };
+
+template<typename T, std::size_t N>
+  struct scalar_simd_abi {
+    using reg = simd_lanes<T, N>;
+    using mask = simd_lanes<bool, N>;
+
+    template<typename Op>
+      static reg apply(reg a, reg b, Op op)
+      {
+        reg r;
+        for (std::size_t i = 0; i != N; ++i)
+          r.v[i] = static_cast<T>(op(a.v[i], b.v[i]));
+        return r;
+      }
+
+    template<typename Op>
+      static mask test(reg a, reg b, Op op)
+      {
+        mask m;
+        for (std::size_t i = 0; i != N; ++i)
+          m.v[i] = op(a.v[i], b.v[i]);
+        return m;
+      }
+
+    template<typename Op>
+      static mask combine(mask a, mask b, Op op)
+      {
+        mask m;
+        for (std::size_t i = 0; i != N; ++i)
+          m.v[i] = op(a.v[i], b.v[i]);
+        return m;
+      }
+
+    static reg load(const T* p)
+    {
+      reg r;
+      std::memcpy(r.v, p, sizeof(r.v));
+      return r;
+    }
+
+    static void store(reg a, T* p) { std::memcpy(p, a.v, sizeof(a.v)); }
+
+    static reg broadcast(T x)
+    {
+      reg r;
+      for (std::size_t i = 0; i != N; ++i)
+        r.v[i] = x;
+      return r;
+    }
+
+    static reg add(reg a, reg b) { return apply(a, b, std::plus<T>()); }
+    static reg sub(reg a, reg b) { return apply(a, b, std::minus<T>()); }
+    static reg mul(reg a, reg b) { return apply(a, b, std::multiplies<T>()); }
+    static reg div(reg a, reg b) { return apply(a, b, std::divides<T>()); }
+    static reg neg(reg a) { return sub(broadcast(T(0)), a); }
+    static reg min(reg a, reg b) { return apply(a, b, [](T x, T y) { return y < x ? y : x; }); }
+    static reg max(reg a, reg b) { return apply(a, b, [](T x, T y) { return x < y ? y : x; }); }
+
+    static reg bit_and(reg a, reg b) { return apply(a, b, std::bit_and<T>()); }
+    static reg bit_or(reg a, reg b) { return apply(a, b, std::bit_or<T>()); }
+    static reg bit_xor(reg a, reg b) { return apply(a, b, std::bit_xor<T>()); }
+    static reg bit_not(reg a) { return bit_xor(a, broadcast(T(~T(0)))); }
+
+    static mask eq(reg a, reg b) { return test(a, b, std::equal_to<T>()); }
+    static mask ne(reg a, reg b) { return test(a, b, std::not_equal_to<T>()); }
+    static mask lt(reg a, reg b) { return test(a, b, std::less<T>()); }
+    static mask le(reg a, reg b) { return test(a, b, std::less_equal<T>()); }
+
+    static reg select(mask m, reg a, reg b)
+    {
+      reg r;
+      for (std::size_t i = 0; i != N; ++i)
+        r.v[i] = m.v[i] ? a.v[i] : b.v[i];
+      return r;
+    }
+
+    static mask mask_and(mask a, mask b) { return combine(a, b, std::logical_and<bool>()); }
+    static mask mask_or(mask a, mask b) { return combine(a, b, std::logical_or<bool>()); }
+    static mask mask_xor(mask a, mask b) { return combine(a, b, std::not_equal_to<bool>()); }
+    static mask mask_not(mask a) { return mask_xor(a, mask_broadcast(true)); }
+
+    static mask mask_broadcast(bool b)
+    {
+      mask m;
+      for (std::size_t i = 0; i != N; ++i)
+        m.v[i] = b;
+      return m;
+    }
+
+    static std::uint64_t mask_bits(mask m)
+    {
+      std::uint64_t bits = 0;
+      for (std::size_t i = 0; i != N; ++i)
+        bits |= std::uint64_t(m.v[i]) << i;
+      return bits;
+    }
+  };
+
+// Lane-by-lane division, for the integer registers, which have no divide instruction.
+template<typename T, std::size_t N, typename Abi>
+  typename Abi::reg divide_lanes(typename Abi::reg a, typename Abi::reg b)
+  {
+    T x[N];
+    T y[N];
+    Abi::store(a, x);
+    Abi::store(b, y);
+    for (std::size_t i = 0; i != N; ++i)
+      x[i] /= y[i];
+    return Abi::load(x);
+  }
+
+// The backend for N lanes of T. The primary template is the array backend; the vector
+// register backends specialize it.
+template<typename T, std::size_t N>
+  struct simd_abi : scalar_simd_abi<T, N> { };
+
+}	// namespace impl
+
+// SSE2, AVX, AVX2 and AVX-512 backends.
+#if defined(ESTD_SIMD_SSE2)
+#include "impl/simd_x86.h"
+#endif
+
+// Does simd<T, N> live in a vector register, rather than in an array?
+template<typename T, std::size_t N>
+  constexpr bool Native_simd()
+  {
+    return !Same<typename impl::simd_abi<T, N>::reg, impl::simd_lanes<T, N>>();
+  }
+
+namespace impl {
+
+// The bitwise operators exist only for integer lanes.
+template<typename T, std::size_t N,
+         bool = Integral<T>()>
+  struct simd_integer_ops { };
+
+template<typename T, std::size_t N>
+  struct simd_integer_ops<T, N, true> {
+    using abi = simd_abi<T, N>;
+    using V = simd<T, N>;
+
+    friend V operator&(const V& a, const V& b) { return V(abi::bit_and(a.native(), b.native())); }
+    friend V operator|(const V& a, const V& b) { return V(abi::bit_or(a.native(), b.native())); }
+    friend V operator^(const V& a, const V& b) { return V(abi::bit_xor(a.native(), b.native())); }
+    friend V operator~(const V& a) { return V(abi::bit_not(a.native())); }
+
+    friend V& operator&=(V& a, const V& b) { return a = a & b; }
+    friend V& operator|=(V& a, const V& b) { return a = a | b; }
+    friend V& operator^=(V& a, const V& b) { return a = a ^ b; }
+  };
+
+}	// namespace impl
+
+template<typename T, std::size_t N>
+  class simd_mask {
+    static_assert(N != 0 && N <= 64, "simd_mask: requires between 1 and 64 lanes");
+
+    using abi = impl::simd_abi<T, N>;
+
+  public:
+    using value_type = bool;
+    using register_type = typename abi::mask;
+
+    static constexpr std::size_t size() { return N; }
+
+    simd_mask() = default;
+
+    explicit simd_mask(bool b) : m(abi::mask_broadcast(b)) { }
+
+    explicit simd_mask(register_type m) : m(m) { }
+
+    register_type native() const { return m; }
+
+    // Bit i is lane i.
+    std::uint64_t bits() const { return abi::mask_bits(m); }
+
+    bool operator[](std::size_t i) const { return (bits() >> i) & 1; }
+
+    friend simd_mask operator&(const simd_mask& a, const simd_mask& b) { return simd_mask(abi::mask_and(a.m, b.m)); }
+    friend simd_mask operator|(const simd_mask& a, const simd_mask& b) { return simd_mask(abi::mask_or(a.m, b.m)); }
+    friend simd_mask operator^(const simd_mask& a, const simd_mask& b) { return simd_mask(abi::mask_xor(a.m, b.m)); }
+    friend simd_mask operator!(const simd_mask& a) { return simd_mask(abi::mask_not(a.m)); }
+
+    friend simd_mask& operator&=(simd_mask& a, const simd_mask& b) { return a = a & b; }
+    friend simd_mask& operator|=(simd_mask& a, const simd_mask& b) { return a = a | b; }
+    friend simd_mask& operator^=(simd_mask& a, const simd_mask& b) { return a = a ^ b; }
+
+    // Whole-mask equality, so that simd_mask is Regular.
+    friend bool operator==(const simd_mask& a, const simd_mask& b) { return a.bits() == b.bits(); }
+    friend bool operator!=(const simd_mask& a, const simd_mask& b) { return a.bits() != b.bits(); }
+
+  private:
+    register_type m;
+  };
+
+// Reductions of a mask.
+
+template<typename T, std::size_t N>
+  inline bool any(const simd_mask<T, N>& m) { return m.bits() != 0; }
+
+template<typename T, std::size_t N>
+  inline bool all(const simd_mask<T, N>& m) { return m.bits() == (~std::uint64_t(0) >> (64 - N)); }
+
+template<typename T, std::size_t N>
+  inline bool none(const simd_mask<T, N>& m) { return m.bits() == 0; }
+
+template<typename T, std::size_t N>
+  inline std::size_t popcount(const simd_mask<T, N>& m) { return impl::popcount(m.bits()); }
+
+// The first lane that is set. The mask must not be empty.
+template<typename T, std::size_t N>
+  inline std::size_t find_first_set(const simd_mask<T, N>& m) { return impl::countr_zero(m.bits()); }
+
+template<typename T, std::size_t N>
+  class simd : public impl::simd_integer_ops<T, N> {
+    static_assert(Arithmetic<T>() && !Same<Remove_cv<T>, bool>(), "simd: requires an arithmetic element type");
+    static_assert(N != 0 && N <= 64, "simd: requires between 1 and 64 lanes");
+
+    using abi = impl::simd_abi<T, N>;
+
+  public:
+    using value_type = T;
+    using mask_type = simd_mask<T, N>;
+    using register_type = typename abi::reg;
+
+    static constexpr std::size_t size() { return N; }
+
+    // Uninitialized, like a T.
+    simd() = default;
+
+    // Every lane is x. Implicit, so that v * 2 means v * simd(2).
+    simd(T x) : r(abi::broadcast(x)) { }
+
+    explicit simd(register_type r) : r(r) { }
+
+    register_type native() const { return r; }
+
+    // Loads and stores of the N values at p, which need not be aligned.
+
+    static simd load(const T* p) { return simd(abi::load(p)); }
+
+    void store(T* p) const { abi::store(r, p); }
+
+    // The first n values at p, for the tail of an array. The other lanes are zero.
+    static simd load_n(const T* p, std::size_t n)
+    {
+      T x[N] = { };
+      for (std::size_t i = 0; i != n && i != N; ++i)
+        x[i] = p[i];
+      return load(x);
+    }
+
+    // Store the first n lanes to p.
+    void store_n(T* p, std::size_t n) const
+    {
+      T x[N];
+      store(x);
+      for (std::size_t i = 0; i != n && i != N; ++i)
+        p[i] = x[i];
+    }
+
+    // Elements i to i + N of a Contiguous_range, which must have that many.
+
+    template<typename R>
+      static auto load(const R& range, std::size_t i)
+        -> Enable_if<Contiguous_range<const R&>(), simd>
+      {
+        static_assert(Same<Remove_cv<Value_type<R>>, T>(), "simd: load requires a range of the element type");
+
+        return load(impl::contiguous_data(range) + i);
+      }
+
+    template<typename R>
+      auto store(R& range, std::size_t i) const
+        -> Enable_if<Contiguous_range<R&>()>
+      {
+        static_assert(Same<Value_type<R>, T>(), "simd: store requires a range of the element type");
+
+        store(impl::contiguous_data(range) + i);
+      }
+
+    // Reads lane i. To read them all, store to an array.
+    T operator[](std::size_t i) const
+    {
+      T x[N];
+      store(x);
+      return x[i];
+    }
+
+    friend simd operator+(const simd& a, const simd& b) { return simd(abi::add(a.r, b.r)); }
+    friend simd operator-(const simd& a, const simd& b) { return simd(abi::sub(a.r, b.r)); }
+    friend simd operator*(const simd& a, const simd& b) { return simd(abi::mul(a.r, b.r)); }
+    friend simd operator/(const simd& a, const simd& b) { return simd(abi::div(a.r, b.r)); }
+    friend simd operator-(const simd& a) { return simd(abi::neg(a.r)); }
+    friend simd operator+(const simd& a) { return a; }
+
+    friend simd& operator+=(simd& a, const simd& b) { return a = a + b; }
+    friend simd& operator-=(simd& a, const simd& b) { return a = a - b; }
+    friend simd& operator*=(simd& a, const simd& b) { return a = a * b; }
+    friend simd& operator/=(simd& a, const simd& b) { return a = a / b; }
+
+    friend mask_type operator==(const simd& a, const simd& b) { return mask_type(abi::eq(a.r, b.r)); }
+    friend mask_type operator!=(const simd& a, const simd& b) { return mask_type(abi::ne(a.r, b.r)); }
+    friend mask_type operator<(const simd& a, const simd& b) { return mask_type(abi::lt(a.r, b.r)); }
+    friend mask_type operator<=(const simd& a, const simd& b) { return mask_type(abi::le(a.r, b.r)); }
+    friend mask_type operator>(const simd& a, const simd& b) { return mask_type(abi::lt(b.r, a.r)); }
+    friend mask_type operator>=(const simd& a, const simd& b) { return mask_type(abi::le(b.r, a.r)); }
+
+    friend simd min(const simd& a, const simd& b) { return simd(abi::min(a.r, b.r)); }
+    friend simd max(const simd& a, const simd& b) { return simd(abi::max(a.r, b.r)); }
+
+    // Lane i is a[i] where m[i] is set, and b[i] elsewhere.
+    friend simd select(const mask_type& m, const simd& a, const simd& b)
+    {
+      return simd(abi::select(m.native(), a.r, b.r));
+    }
+
+  private:
+    register_type r;
+  };
+
+// The scalar forms of select, min and max, for code written for both T and simd<T>.
+
+inline bool any(bool b) { return b; }
+
+inline bool all(bool b) { return b; }
+
+inline bool none(bool b) { return !b; }
+
+template<typename T>
+  inline auto select(bool m, const T& a, const T& b)
+    -> Enable_if<Arithmetic<T>(), T>
+  {
+    return m ? a : b;
+  }
+
+template<typename T>
+  inline auto min(const T& a, const T& b)
+    -> Enable_if<Arithmetic<T>(), T>
+  {
+    return b < a ? b : a;
+  }
+
+template<typename T>
+  inline auto max(const T& a, const T& b)
+    -> Enable_if<Arithmetic<T>(), T>
+  {
+    return a < b ? b : a;
+  }
+
+// Horizontal reductions: the sum, minimum and maximum of the lanes. The sum is formed as a
+// tree, like the unrolled sums in numeric.h.
+
+namespace impl {
+
+template<typename T, typename Op>
+  T reduce_lanes(const T* x, std::size_t n, Op op)
+  {
+    if (n == 1)
+      return x[0];
+    std::size_t half = n / 2;
+    return op(reduce_lanes(x, half, op), reduce_lanes(x + half, n - half, op));
+  }
+
+}	// namespace impl
+
+template<typename T, std::size_t N>
+  T reduce(const simd<T, N>& v)
+  {
+    T x[N];
+    v.store(x);
+    return impl::reduce_lanes(x, N, std::plus<T>());
+  }
+
+template<typename T, std::size_t N>
+  T reduce_min(const simd<T, N>& v)
+  {
+    T x[N];
+    v.store(x);
+    return impl::reduce_lanes(x, N, [](T a, T b) { return b < a ? b : a; });
+  }
+
+template<typename T, std::size_t N>
+  T reduce_max(const simd<T, N>& v)
+  {
+    T x[N];
+    v.store(x);
+    return impl::reduce_lanes(x, N, [](T a, T b) { return a < b ? b : a; });
+  }
+
+}	// namespace Estd
+
+#endif	// SIMD_H
@@ -0,0 +1,452 @@
+#ifndef SOA_VECTOR_H
+#define SOA_VECTOR_H
+
+#include "constraints.h"
+#include "iterator_facade.h"
+#include "memory.h"
+#include "platform.h"
+#include "span.h"
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <utility>
+
+// soa_vector<Fields...> is a sequence of records stored as a structure of arrays:
+// each field has its own contiguous column. A loop that reads two fields of a wide record
+// only brings those two columns into the cache, and each column can be handed to a SIMD
+// kernel as a span.
+//
+// The records themselves are tuples. soa_vector<float, float, int> holds rows that read as
+// std::tuple<float, float, int>; iterating yields std::tuple<float&, float&, int&>, through
+// which the row can be read and assigned. The iterators are random access.
+//
+//   soa_vector<float, float, int> particles;
+//   particles.emplace_back(0.f, 1.f, 7);
+//   for (float& x : particles.column<0>()) x += 1;
+//
+// All columns live in one allocation, and each starts on a cache line, so a column is
+// aligned for any SIMD load. Growth is geometric, as for std::vector. Rows are moved to
+// new storage if the move constructors of all the fields don't throw, and copied otherwise,
+// so a throwing reallocation leaves the container unchanged. The choice is made for the
+// whole row: moving one column and then failing to copy the next would leave the old rows
+// moved from. A row with a field that can only be moved is moved, and then has no such
+// guarantee, as for std::vector.
+
+namespace Estd {
+
+namespace impl {
+
+inline std::size_t cache_line_round(std::size_t n)
+{
+  return (n + cache_line_size - 1) & ~(cache_line_size - 1);
+}
+
+// Move [first, last) to out when Move is true, and copy it otherwise.
+template<typename T, bool Move>
+  void uninitialized_move_or_copy(T* first, T* last, T* out, boolean_constant<Move>)
+  {
+    using I = Conditional<Move, std::move_iterator<T*>, const T*>;
+    std::uninitialized_copy(I(first), I(last), out);
+  }
+
+template<typename T>
+  void destroy(T* first, T* last)
+  {
+    for (; first != last; ++first)
+      first->~T();
+  }
+
+// The row iterator of a soa_vector. It keeps the column pointers and an index, so that
+// a loop over a range of rows is a loop over an index.
+template<bool Const, typename... Fields>
+  class soa_iterator
+    : public iterator_facade<soa_iterator<Const, Fields...>,
+                             std::tuple<Fields...>,
+                             std::tuple<Conditional<Const, const Fields&, Fields&>...>,
+                             std::random_access_iterator_tag>
+  {
+    using facade = iterator_facade<soa_iterator<Const, Fields...>,
+                                   std::tuple<Fields...>,
+                                   std::tuple<Conditional<Const, const Fields&, Fields&>...>,
+                                   std::random_access_iterator_tag>;
+    friend facade;
+
+    using columns = std::tuple<Conditional<Const, const Fields*, Fields*>...>;
+    using indices = index_sequence_for<Fields...>;
+
+  public:
+    soa_iterator() : cols(), i() { }
+
+    soa_iterator(columns cols, std::ptrdiff_t i) : cols(cols), i(i) { }
+
+    // iterator converts to const_iterator.
+    template<bool C,
+             typename = Enable_if<Const && !C>>
+      soa_iterator(const soa_iterator<C, Fields...>& x)
+        : cols(x.base()), i(x.index())
+      { }
+
+    const columns& base() const { return cols; }
+    std::ptrdiff_t index() const { return i; }
+
+  private:
+    typename facade::reference dereference() const { return dereference(indices{}); }
+
+    template<std::size_t... N>
+      typename facade::reference dereference(index_sequence<N...>) const
+      {
+        return typename facade::reference(std::get<N>(cols)[i]...);
+      }
+
+    bool equal(const soa_iterator& x) const { return i == x.i; }
+    void increment() { ++i; }
+    void decrement() { --i; }
+    void advance(std::ptrdiff_t n) { i += n; }
+    std::ptrdiff_t distance_to(const soa_iterator& x) const { return x.i - i; }
+
+    columns cols;
+    std::ptrdiff_t i;
+  };
+
+}	// namespace impl
+
+template<typename... Fields>
+  class soa_vector {
+    static_assert(sizeof...(Fields) > 0, "soa_vector: requires at least one field");
+    static_assert(impl::all_of<Movable<Fields>()...>(), "soa_vector: the fields must be Movable");
+    static_assert(impl::all_of<(alignof(Fields) <= cache_line_size)...>(),
+                  "soa_vector: a field is over-aligned for a cache line");
+
+    using columns = std::tuple<Fields*...>;
+    using indices = index_sequence_for<Fields...>;
+    using allocator = aligned_allocator<unsigned char>;
+
+    static constexpr std::size_t field_count = sizeof...(Fields);
+
+    // Are rows moved, rather than copied, into new storage?
+    static constexpr bool move_rows = impl::all_of<Nothrow_move_constructible<Fields>()...>()
+                                   || !impl::all_of<Copy_constructible<Fields>()...>();
+
+  public:
+    using value_type = std::tuple<Fields...>;
+    using reference = std::tuple<Fields&...>;
+    using const_reference = std::tuple<const Fields&...>;
+    using iterator = impl::soa_iterator<false, Fields...>;
+    using const_iterator = impl::soa_iterator<true, Fields...>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    template<std::size_t N>
+      using field_type = typename std::tuple_element<N, value_type>::type;
+
+    soa_vector() noexcept
+      : block(nullptr), cols(), n(0), cap(0)
+    { }
+
+    // n value-initialized rows.
+    explicit soa_vector(size_type n)
+      : soa_vector()
+    {
+      resize(n);
+    }
+
+    soa_vector(std::initializer_list<value_type> list)
+      : soa_vector()
+    {
+      reserve(list.size());
+      for (const value_type& row : list)
+        push_back(row);
+    }
+
+    soa_vector(const soa_vector& x)
+      : soa_vector()
+    {
+      reserve(x.n);
+      for (size_type i = 0; i != x.n; ++i)
+        emplace_row(x.row(i, indices{}), indices{});
+    }
+
+    soa_vector(soa_vector&& x) noexcept
+      : block(x.block), cols(x.cols), n(x.n), cap(x.cap)
+    {
+      x.block = nullptr;
+      x.cols = columns();
+      x.n = x.cap = 0;
+    }
+
+    ~soa_vector()
+    {
+      clear();
+      allocator().deallocate(block, bytes(cap));
+    }
+
+    soa_vector& operator=(const soa_vector& x)
+    {
+      if (this != &x) {
+        soa_vector tmp(x);
+        swap(tmp);
+      }
+      return *this;
+    }
+
+    soa_vector& operator=(soa_vector&& x) noexcept
+    {
+      soa_vector tmp(std::move(x));
+      swap(tmp);
+      return *this;
+    }
+
+    void swap(soa_vector& x) noexcept
+    {
+      std::swap(block, x.block);
+      std::swap(cols, x.cols);
+      std::swap(n, x.n);
+      std::swap(cap, x.cap);
+    }
+
+    // Size and capacity
+
+    size_type size() const { return n; }
+    size_type capacity() const { return cap; }
+    bool empty() const { return n == 0; }
+
+    void reserve(size_type c)
+    {
+      if (c > cap)
+        reallocate(c);
+    }
+
+    void clear() noexcept
+    {
+      destroy_rows(cols, 0, n, indices{});
+      n = 0;
+    }
+
+    void resize(size_type count)
+    {
+      if (count < n) {
+        destroy_rows(cols, count, n, indices{});
+        n = count;
+        return;
+      }
+      reserve(count);
+      while (n != count)
+        emplace_row(std::tuple<>(), index_sequence<>{});
+    }
+
+    // Rows
+
+    void push_back(const value_type& row) { emplace_row(row, indices{}); }
+    void push_back(value_type&& row) { emplace_row(std::move(row), indices{}); }
+
+    // Construct a row from one argument per field.
+    template<typename... Args>
+      void emplace_back(Args&&... args)
+      {
+        static_assert(sizeof...(Args) == field_count, "soa_vector: emplace_back takes one argument per field");
+        emplace_row(std::forward_as_tuple(std::forward<Args>(args)...), indices{});
+      }
+
+    void pop_back()
+    {
+      destroy_rows(cols, n - 1, n, indices{});
+      --n;
+    }
+
+    reference operator[](size_type i) { return row(i, indices{}); }
+    const_reference operator[](size_type i) const { return row(i, indices{}); }
+
+    reference front() { return (*this)[0]; }
+    const_reference front() const { return (*this)[0]; }
+    reference back() { return (*this)[n - 1]; }
+    const_reference back() const { return (*this)[n - 1]; }
+
+    iterator begin() { return iterator(cols, 0); }
+    iterator end() { return iterator(cols, n); }
+    const_iterator begin() const { return const_iterator(const_columns(indices{}), 0); }
+    const_iterator end() const { return const_iterator(const_columns(indices{}), n); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    // Columns
+
+    template<std::size_t N>
+      field_type<N>* data() { return std::get<N>(cols); }
+
+    template<std::size_t N>
+      const field_type<N>* data() const { return std::get<N>(cols); }
+
+    template<std::size_t N>
+      span<field_type<N>> column() { return span<field_type<N>>(std::get<N>(cols), n); }
+
+    template<std::size_t N>
+      span<const field_type<N>> column() const { return span<const field_type<N>>(std::get<N>(cols), n); }
+
+  private:
+    // The size of a block holding c rows: each column is padded to a whole number of cache lines.
+    static std::size_t bytes(size_type c)
+    {
+      std::size_t sizes[] = { impl::cache_line_round(c * sizeof(Fields))... };
+      std::size_t total = 0;
+      for (std::size_t s : sizes)
+        total += s;
+      return total;
+    }
+
+    template<std::size_t... N>
+      static columns carve(unsigned char* p, size_type c, index_sequence<N...>)
+      {
+        std::size_t sizes[] = { impl::cache_line_round(c * sizeof(Fields))... };
+        std::size_t offsets[field_count] = { };
+        for (std::size_t k = 1; k != field_count; ++k)
+          offsets[k] = offsets[k - 1] + sizes[k - 1];
+        return columns(reinterpret_cast<Fields*>(p + offsets[N])...);
+      }
+
+    template<std::size_t... N>
+      std::tuple<const Fields*...> const_columns(index_sequence<N...>) const
+      {
+        return std::tuple<const Fields*...>(std::get<N>(cols)...);
+      }
+
+    template<std::size_t... N>
+      reference row(size_type i, index_sequence<N...>) { return reference(std::get<N>(cols)[i]...); }
+
+    template<std::size_t... N>
+      const_reference row(size_type i, index_sequence<N...>) const { return const_reference(std::get<N>(cols)[i]...); }
+
+    void reallocate(size_type c)
+    {
+      unsigned char* p = allocator().allocate(bytes(c));
+      columns to = carve(p, c, indices{});
+      try {
+        relocate(to, size_constant<0>{});
+      }
+      catch (...) {
+        allocator().deallocate(p, bytes(c));
+        throw;
+      }
+      adopt(p, to, c);
+    }
+
+    // Free the old storage and take the storage at p, of capacity c, whose columns are to,
+    // and which holds the rows.
+    void adopt(unsigned char* p, const columns& to, size_type c) noexcept
+    {
+      destroy_rows(cols, 0, n, indices{});
+      allocator().deallocate(block, bytes(cap));
+      block = p;
+      cols = to;
+      cap = c;
+    }
+
+    // Move or copy the columns from K on into new storage. If a column throws, the
+    // columns already built are destroyed, and the old storage is untouched.
+    template<std::size_t K>
+      void relocate(const columns& to, size_constant<K>)
+      {
+        field_type<K>* from = std::get<K>(cols);
+        impl::uninitialized_move_or_copy(from, from + n, std::get<K>(to), boolean_constant<move_rows>{});
+        try {
+          relocate(to, size_constant<K + 1>{});
+        }
+        catch (...) {
+          impl::destroy(std::get<K>(to), std::get<K>(to) + n);
+          throw;
+        }
+      }
+
+    void relocate(const columns&, size_constant<field_count>) { }
+
+    // Append a row whose fields are constructed from the elements N... of args; with no
+    // indices, the fields are value-initialized. When the storage is full, the new row is
+    // built in the new storage before the old rows are moved there, since args may refer
+    // to those rows, as in v.emplace_back(std::get<0>(v[0]), ...).
+    template<typename Tuple, std::size_t... N>
+      void emplace_row(Tuple&& args, index_sequence<N...>)
+      {
+        using has_args = boolean_constant<(sizeof...(N) != 0)>;
+        if (n != cap) {
+          construct(cols, std::forward<Tuple>(args), has_args{}, size_constant<0>{});
+          ++n;
+          return;
+        }
+
+        const size_type c = cap ? 2 * cap : 8;
+        unsigned char* p = allocator().allocate(bytes(c));
+        columns to = carve(p, c, indices{});
+        try {
+          construct(to, std::forward<Tuple>(args), has_args{}, size_constant<0>{});
+        }
+        catch (...) {
+          allocator().deallocate(p, bytes(c));
+          throw;
+        }
+        try {
+          relocate(to, size_constant<0>{});
+        }
+        catch (...) {
+          destroy_rows(to, n, n + 1, indices{});
+          allocator().deallocate(p, bytes(c));
+          throw;
+        }
+        adopt(p, to, c);
+        ++n;
+      }
+
+    // Construct field K of row n of the columns at, then the following fields. If a later
+    // field throws, this one is destroyed again.
+    template<typename Tuple, bool Args, std::size_t K>
+      void construct(const columns& at, Tuple&& args, boolean_constant<Args> a, size_constant<K>)
+      {
+        using F = field_type<K>;
+        F* p = std::get<K>(at) + n;
+        construct_field(p, std::forward<Tuple>(args), a, size_constant<K>{});
+        try {
+          construct(at, std::forward<Tuple>(args), a, size_constant<K + 1>{});
+        }
+        catch (...) {
+          p->~F();
+          throw;
+        }
+      }
+
+    template<typename Tuple, bool Args>
+      void construct(const columns&, Tuple&&, boolean_constant<Args>, size_constant<field_count>) { }
+
+    template<typename F, typename Tuple, std::size_t K>
+      static void construct_field(F* p, Tuple&& args, boolean_constant<true>, size_constant<K>)
+      {
+        ::new (static_cast<void*>(p)) F(std::get<K>(std::forward<Tuple>(args)));
+      }
+
+    template<typename F, typename Tuple, std::size_t K>
+      static void construct_field(F* p, Tuple&&, boolean_constant<false>, size_constant<K>)
+      {
+        ::new (static_cast<void*>(p)) F();
+      }
+
+    template<std::size_t... N>
+      static void destroy_rows(const columns& at, size_type first, size_type last, index_sequence<N...>)
+      {
+        impl::expand((impl::destroy(std::get<N>(at) + first, std::get<N>(at) + last), 0)...);
+      }
+
+    unsigned char* block;
+    columns cols;
+    size_type n;
+    size_type cap;
+  };
+
+template<typename... Fields>
+  void swap(soa_vector<Fields...>& a, soa_vector<Fields...>& b) noexcept
+  {
+    a.swap(b);
+  }
+
+}	// namespace Estd
+
+#endif	// SOA_VECTOR_H
@@ -0,0 +1,75 @@
+#ifndef SPAN_H
+#define SPAN_H
+
+#include "constraints.h"
+#include <cstddef>
+
+// span<T> is a view of a contiguous array: a pointer and a length, after C++20's std::span
+// with a dynamic extent. It is a Contiguous_range, so the reductions in numeric.h and the
+// algorithms see through it to the pointers.
+//
+// A span doesn't own its elements, and is invalidated with the storage it refers to.
+
+namespace Estd {
+
+template<typename T>
+  class span {
+  public:
+    using element_type = T;
+    using value_type = Remove_cv<T>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = T*;
+
+    constexpr span() noexcept : p(nullptr), n(0) { }
+
+    constexpr span(T* p, size_type n) noexcept : p(p), n(n) { }
+
+    constexpr span(T* first, T* last) noexcept : p(first), n(last - first) { }
+
+    template<std::size_t N>
+      constexpr span(T (&a)[N]) noexcept : p(a), n(N) { }
+
+    // A contiguous range of elements whose pointers convert to T*, without slicing:
+    // std::vector<int> to span<const int>, but not std::vector<derived> to span<base>.
+    template<typename R,
+             typename = Enable_if<!Same<Decay<R>, span>()
+                               && Contiguous_range<R&>()
+                               && Convertible<Remove_pointer<Member_data<R&>> (*)[], T (*)[]>()>>
+      constexpr span(R& r) : p(r.data()), n(r.size()) { }
+
+    template<typename U,
+             typename = Enable_if<Convertible<U (*)[], T (*)[]>()>>
+      constexpr span(const span<U>& s) noexcept : p(s.data()), n(s.size()) { }
+
+    constexpr T* data() const noexcept { return p; }
+    constexpr size_type size() const noexcept { return n; }
+    constexpr size_type size_bytes() const noexcept { return n * sizeof(T); }
+    constexpr bool empty() const noexcept { return n == 0; }
+
+    constexpr T* begin() const noexcept { return p; }
+    constexpr T* end() const noexcept { return p + n; }
+
+    constexpr T& operator[](size_type i) const { return p[i]; }
+    constexpr T& front() const { return p[0]; }
+    constexpr T& back() const { return p[n - 1]; }
+
+    // Subspans. The counts must not exceed the size.
+    constexpr span first(size_type count) const { return span(p, count); }
+    constexpr span last(size_type count) const { return span(p + (n - count), count); }
+
+    constexpr span subspan(size_type offset) const { return span(p + offset, n - offset); }
+    constexpr span subspan(size_type offset, size_type count) const { return span(p + offset, count); }
+
+  private:
+    T* p;
+    size_type n;
+  };
+
+}	// namespace Estd
+
+#endif	// SPAN_H
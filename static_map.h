@@ -0,0 +1,300 @@
+#ifndef STATIC_MAP_H
+#define STATIC_MAP_H
+
+#include "constraints.h"
+#include "platform.h"
+#include "string_ref.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+// static_map<K, V, N> is an immutable map of N keys known when it is made, such as the
+// names of commands or of protocol headers, with a perfect hash: every key has a slot of
+// its own, so a lookup is one hash of the key and one comparison, with no probing and no
+// chains.
+//
+//   constexpr auto methods = make_static_map<string_ref, int>({
+//     {"GET", 1}, {"PUT", 2}, {"POST", 3}, {"DELETE", 4}
+//   });
+//   static_assert(methods.at("PUT") == 2, "");
+//
+// From C++14 the table is built at compile time, and the map can be a constant; in C++11
+// it is built when the map is made.
+//
+// The table is built by hash and displace. The keys are hashed once, and split into
+// buckets by their hash. The buckets of two or more keys, largest first, each look for a
+// seed that sends their keys to distinct free slots when mixed into the hash; the buckets
+// of one key then take the free slots that are left. A lookup reads its bucket's entry,
+// which is either the seed or the slot, and compares the key in that slot. There are twice
+// as many slots as keys, rounded up to a power of 2, and half as many buckets as slots, so
+// nearly every bucket finds its seed in a few tries.
+//
+// The keys are hashed with static_hash<K>, a constexpr function object that covers the
+// integers, the enumerations, string_ref and std::string; specialize it for other key
+// types. Two keys with the same 64-bit hash, equal or not, are reported when the map is
+// made, by an exception (or, at compile time, as an error).
+//
+// static_map has the member types of the standard associative containers, so the
+// Associated_key_type and Associated_mapped_type detectors see it as one. It iterates in
+// the order the keys were given.
+
+namespace Estd {
+
+namespace impl {
+
+constexpr std::uint64_t mix_shift(std::uint64_t x, unsigned s)
+{
+  return x ^ (x >> s);
+}
+
+// The finalizer of splitmix64: every bit of x affects every bit of the result.
+constexpr std::uint64_t mix64(std::uint64_t x)
+{
+  return mix_shift(mix_shift(mix_shift(x, 30) * 0xbf58476d1ce4e5b9u, 27) * 0x94d049bb133111ebu, 31);
+}
+
+}	// namespace impl
+
+template<typename K>
+  struct static_hash {
+    static_assert(Integral<K>() || Enum<K>(), "static_hash: no hash for the key type; specialize static_hash");
+
+    constexpr std::uint64_t operator()(K k) const { return impl::mix64(static_cast<std::uint64_t>(k)); }
+  };
+
+namespace impl {
+
+// The chars p[i] and p[0] to p[3] as little-endian words. Written out, rather than as a
+// loop, so that the compiler sees through them to a single load at any optimization level.
+constexpr std::uint64_t load_char(const char* p, std::size_t i)
+{
+  return std::uint64_t(static_cast<unsigned char>(p[i])) << (8 * i);
+}
+
+constexpr std::uint64_t load4(const char* p)
+{
+  return load_char(p, 0) | load_char(p, 1) | load_char(p, 2) | load_char(p, 3);
+}
+
+constexpr std::uint64_t load8(const char* p)
+{
+  return load4(p) | load4(p + 4) << 32;
+}
+
+// The last word of n chars, 0 < n <= 8, in at most two loads: 4 to 8 chars are two
+// overlapping runs of 4, and 1 to 3 chars are the first, middle and last. The length is
+// hashed separately, so the overlap loses nothing.
+constexpr std::uint64_t load_tail(const char* p, std::size_t n)
+{
+  return n >= 4 ? load4(p) | load4(p + n - 4) << 32
+                : load_char(p, 0) | load_char(p + n / 2, 0) << 8 | load_char(p + n - 1, 0) << 16;
+}
+
+// One multiply per word of 8 chars; the last word, which overlaps the one before it when n
+// is over 8 and not a multiple of 8, goes through the splitmix64 finalizer.
+inline ESTD_CXX14_CONSTEXPR std::uint64_t hash_chars(const char* p, std::size_t n)
+{
+  std::uint64_t h = 0x9e3779b97f4a7c15u ^ n * 0x94d049bb133111ebu;
+  if (n == 0)
+    return mix64(h);
+  if (n <= 8)
+    return mix64(h ^ load_tail(p, n));
+  const char* last = p + n - 8;
+  for (; p < last; p += 8) {
+    h = (h ^ load8(p)) * 0xbf58476d1ce4e5b9u;
+    h ^= h >> 29;
+  }
+  return mix64(h ^ load8(last));
+}
+
+}	// namespace impl
+
+// 8 chars at a time, each word mixed into the state.
+template<>
+  struct static_hash<string_ref> {
+    ESTD_CXX14_CONSTEXPR std::uint64_t operator()(string_ref s) const { return impl::hash_chars(s.data(), s.size()); }
+  };
+
+template<>
+  struct static_hash<std::string> {
+    std::uint64_t operator()(const std::string& s) const { return static_hash<string_ref>()(s); }
+  };
+
+namespace impl {
+
+constexpr std::size_t ceil_pow2(std::size_t n, std::size_t m = 1)
+{
+  return m >= n ? m : ceil_pow2(n, m * 2);
+}
+
+// A perfect hash of N keys into M slots, through M / 2 buckets.
+//
+// disp[b] is the entry of bucket b: a seed, which is even, or 2s + 1 for a bucket whose
+// only key is in slot s. slot[s] is the index of the key in slot s, or N if it is free.
+template<std::size_t N, std::size_t M = ceil_pow2(2 * N)>
+  struct perfect_hash {
+    static constexpr std::size_t buckets = M / 2;
+
+    using index_type = Smallest_unsigned<N>;
+
+    std::uint32_t disp[buckets];
+    index_type slot[M];
+
+    static constexpr std::size_t bucket(std::uint64_t h) { return h & (buckets - 1); }
+
+    static constexpr std::size_t position(std::uint64_t h, std::uint32_t d)
+    {
+      return d & 1 ? d >> 1 : mix64(h ^ d) & (M - 1);
+    }
+
+    // The index of the only key that can have hash h, or N.
+    constexpr std::size_t find(std::uint64_t h) const
+    {
+      return slot[position(h, disp[bucket(h)])];
+    }
+
+    template<typename Item, typename Hash>
+      static ESTD_CXX14_CONSTEXPR perfect_hash build(const Item (&items)[N], Hash hash);
+  };
+
+template<std::size_t N, std::size_t M>
+  template<typename Item, typename Hash>
+    ESTD_CXX14_CONSTEXPR perfect_hash<N, M> perfect_hash<N, M>::build(const Item (&items)[N], Hash hash)
+    {
+      perfect_hash t = { };
+      std::uint64_t h[N] = { };
+      for (std::size_t i = 0; i != N; ++i) {
+        h[i] = hash(items[i].first);
+        for (std::size_t j = 0; j != i; ++j)
+          if (h[i] == h[j])
+            throw std::invalid_argument(items[i].first == items[j].first
+                                        ? "static_map: duplicate key"
+                                        : "static_map: two keys have the same hash");
+      }
+
+      // Sort the keys by bucket: the keys of bucket b are member[first[b]] to member[first[b + 1]].
+      std::size_t first[buckets + 1] = { };
+      std::size_t member[N] = { };
+      std::size_t largest = 0;
+      for (std::size_t i = 0; i != N; ++i)
+        ++first[bucket(h[i]) + 1];
+      for (std::size_t b = 0; b != buckets; ++b) {
+        if (first[b + 1] > largest)
+          largest = first[b + 1];
+        first[b + 1] += first[b];
+      }
+      std::size_t filled[buckets] = { };
+      for (std::size_t i = 0; i != N; ++i)
+        member[first[bucket(h[i])] + filled[bucket(h[i])]++] = i;
+
+      for (std::size_t s = 0; s != M; ++s)
+        t.slot[s] = index_type(N);
+
+      // The buckets of two or more keys, largest first.
+      std::size_t pos[N] = { };
+      for (std::size_t size = largest; size >= 2; --size)
+        for (std::size_t b = 0; b != buckets; ++b) {
+          if (first[b + 1] - first[b] != size)
+            continue;
+          for (std::uint32_t d = 2; ; d += 2) {
+            bool ok = true;
+            for (std::size_t k = 0; k != size && ok; ++k) {
+              pos[k] = position(h[member[first[b] + k]], d);
+              ok = t.slot[pos[k]] == N;
+              for (std::size_t j = 0; j != k && ok; ++j)
+                ok = pos[j] != pos[k];
+            }
+            if (ok) {
+              for (std::size_t k = 0; k != size; ++k)
+                t.slot[pos[k]] = index_type(member[first[b] + k]);
+              t.disp[b] = d;
+              break;
+            }
+          }
+        }
+
+      // The buckets of one key.
+      std::size_t free = 0;
+      for (std::size_t b = 0; b != buckets; ++b)
+        if (first[b + 1] - first[b] == 1) {
+          while (t.slot[free] != N)
+            ++free;
+          t.slot[free] = index_type(member[first[b]]);
+          t.disp[b] = std::uint32_t(2 * free + 1);
+        }
+      return t;
+    }
+
+}	// namespace impl
+
+template<typename K, typename V, std::size_t N, typename Hash = static_hash<K>>
+  class static_map {
+    static_assert(Equality_comparable<K>(), "static_map: the key type must be Equality_comparable");
+    static_assert(N != 0, "static_map: requires at least one key");
+
+  public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<const K, V>;
+    using hasher = Hash;
+    using key_equal = std::equal_to<K>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = const value_type&;
+    using const_reference = const value_type&;
+    using pointer = const value_type*;
+    using const_pointer = const value_type*;
+    using iterator = const value_type*;
+    using const_iterator = const value_type*;
+
+    ESTD_CXX14_CONSTEXPR static_map(const value_type (&list)[N])
+      : static_map(list, make_index_sequence<N>{})
+    { }
+
+    static constexpr size_type size() { return N; }
+    static constexpr bool empty() { return false; }
+
+    constexpr const_iterator begin() const { return items; }
+    constexpr const_iterator end() const { return items + N; }
+
+    ESTD_CXX14_CONSTEXPR const_iterator find(const K& k) const
+    {
+      std::size_t i = table.find(Hash()(k));
+      return i != N && items[i].first == k ? items + i : end();
+    }
+
+    ESTD_CXX14_CONSTEXPR size_type count(const K& k) const { return find(k) != end(); }
+
+    ESTD_CXX14_CONSTEXPR bool contains(const K& k) const { return find(k) != end(); }
+
+    ESTD_CXX14_CONSTEXPR const V& at(const K& k) const
+    {
+      const_iterator p = find(k);
+      if (p == end())
+        throw std::out_of_range("static_map: no such key");
+      return p->second;
+    }
+
+  private:
+    template<std::size_t... I>
+      ESTD_CXX14_CONSTEXPR static_map(const value_type (&list)[N], index_sequence<I...>)
+        : items{list[I]...}, table(impl::perfect_hash<N>::build(list, Hash()))
+      { }
+
+    value_type items[N];
+    impl::perfect_hash<N> table;
+  };
+
+// The map of the N items in list, as in make_static_map<string_ref, int>({{"a", 1}, {"b", 2}}).
+template<typename K, typename V, typename Hash = static_hash<K>, std::size_t N>
+  ESTD_CXX14_CONSTEXPR static_map<K, V, N, Hash> make_static_map(const std::pair<const K, V> (&list)[N])
+  {
+    return static_map<K, V, N, Hash>(list);
+  }
+
+}	// namespace Estd
+
+#endif	// STATIC_MAP_H
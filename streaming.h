@@ -0,0 +1,35 @@
+#ifndef STREAMING_H
+#define STREAMING_H
+
+#include "core.h"
+#include <iosfwd>
+
+// Detectors for the stream operators, and the Streamable concept. This is the only facet
+// that includes <iosfwd>.
+
+namespace Estd {
+
+// Handle the overloaded stream operators.
+#include "impl/streamable.h"
+
+template<typename T, typename U = default_t>
+  constexpr bool Output_streamable()
+  {
+    return impl::is_output_streamable<T, U>::value;
+  }
+
+template<typename T, typename U = default_t>
+  constexpr bool Input_streamable()
+  {
+    return impl::is_input_streamable<T, U>::value;
+  }
+
+template<typename T, typename U = default_t>
+  constexpr bool Streamable()
+  {
+    return Input_streamable<T, U>() && Output_streamable<T, U>();
+  }
+
+}	// namespace Estd
+
+#endif	// STREAMING_H
@@ -0,0 +1,97 @@
+#ifndef STRING_REF_H
+#define STRING_REF_H
+
+#include "platform.h"
+#include <cstddef>
+#include <string>
+
+// string_ref is a view of a sequence of chars: a pointer and a length, after C++17's
+// std::string_view. It exists so that strings can be constants and keys of the compile-time
+// tables (see static_map.h) before C++17. Comparison is by content.
+//
+// The operations are constexpr from C++14; in C++11 a string_ref can still be a constant
+// when it is made from a pointer and a length.
+//
+// A string_ref doesn't own its chars, and is invalidated with the storage it refers to.
+
+namespace Estd {
+
+namespace impl {
+
+// The length of the null-terminated string s.
+inline ESTD_CXX14_CONSTEXPR std::size_t string_length(const char* s)
+{
+  std::size_t n = 0;
+  while (s[n] != '\0')
+    ++n;
+  return n;
+}
+
+// <0, 0 or >0 as [a, a + m) is before, equal to or after [b, b + n). GCC and Clang
+// evaluate __builtin_memcmp in constant expressions, and call memcmp at run time, which is
+// several times faster than the loop on strings of more than a few chars.
+inline ESTD_CXX14_CONSTEXPR int compare_chars(const char* a, std::size_t m, const char* b, std::size_t n)
+{
+#if defined(__GNUC__)
+  if (int c = __builtin_memcmp(a, b, m < n ? m : n))
+    return c;
+#else
+  for (std::size_t i = 0; i != m && i != n; ++i)
+    if (a[i] != b[i])
+      return static_cast<unsigned char>(a[i]) < static_cast<unsigned char>(b[i]) ? -1 : 1;
+#endif
+  return m < n ? -1 : m != n;
+}
+
+}	// namespace impl
+
+class string_ref {
+public:
+  using value_type = char;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using const_pointer = const char*;
+  using const_reference = const char&;
+  using iterator = const char*;
+  using const_iterator = const char*;
+
+  constexpr string_ref() noexcept : p(""), n(0) { }
+
+  constexpr string_ref(const char* p, size_type n) noexcept : p(p), n(n) { }
+
+  // A null-terminated string.
+  ESTD_CXX14_CONSTEXPR string_ref(const char* s) noexcept : p(s), n(impl::string_length(s)) { }
+
+  string_ref(const std::string& s) noexcept : p(s.data()), n(s.size()) { }
+
+  constexpr const char* data() const noexcept { return p; }
+  constexpr size_type size() const noexcept { return n; }
+  constexpr bool empty() const noexcept { return n == 0; }
+
+  constexpr const char& operator[](size_type i) const { return p[i]; }
+
+  constexpr iterator begin() const noexcept { return p; }
+  constexpr iterator end() const noexcept { return p + n; }
+
+  std::string str() const { return std::string(p, n); }
+
+  friend ESTD_CXX14_CONSTEXPR bool operator==(string_ref a, string_ref b)
+  {
+    return a.n == b.n && impl::compare_chars(a.p, a.n, b.p, b.n) == 0;
+  }
+
+  friend ESTD_CXX14_CONSTEXPR bool operator!=(string_ref a, string_ref b) { return !(a == b); }
+
+  friend ESTD_CXX14_CONSTEXPR bool operator<(string_ref a, string_ref b) { return impl::compare_chars(a.p, a.n, b.p, b.n) < 0; }
+  friend ESTD_CXX14_CONSTEXPR bool operator>(string_ref a, string_ref b) { return b < a; }
+  friend ESTD_CXX14_CONSTEXPR bool operator<=(string_ref a, string_ref b) { return !(b < a); }
+  friend ESTD_CXX14_CONSTEXPR bool operator>=(string_ref a, string_ref b) { return !(a < b); }
+
+private:
+  const char* p;
+  size_type n;
+};
+
+}	// namespace Estd
+
+#endif	// STRING_REF_H
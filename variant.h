@@ -0,0 +1,662 @@
+#ifndef VARIANT_H
+#define VARIANT_H
+
+#include "constraints.h"
+#include "meta_support.h"
+#include "platform.h"
+#include <cstddef>
+#include <exception>
+#include <new>
+#include <utility>
+
+// variant<Ts...> holds a value of one of the types Ts, after C++17's std::variant.
+//
+// The alternatives share a union, built as a balanced tree of unions over the halves of
+// Ts, so that constructing or reaching alternative I takes log(N) steps of instantiation
+// rather than I. The index of the alternative is the smallest unsigned type that holds N
+// (see Smallest_unsigned): a byte for up to 255 alternatives.
+//
+// Every operation that depends on the alternative at run time - destruction, copy, move,
+// comparison and visit - looks up a function in a constexpr table, indexed by the index of
+// the alternative, and calls it: one indirect call whatever the number of alternatives,
+// where a chain of tests grows with it, and one small function per alternative rather
+// than the whole chain inlined at each call.
+//
+// variant<Ts...> is trivially copyable when every alternative is, and trivially
+// destructible when every alternative is: a variant of messages that are plain structs can
+// be copied with memcpy and kept in the containers that rely on that.
+//
+// A variant is made from, or assigned, a value of any type U that converts to one of the
+// alternatives, which is chosen as std::variant chooses it: by overload resolution among
+// one function per alternative T, leaving out the T that U only converts to by narrowing,
+// as T x[] = {u} does. So variant<std::string, int> v = "x" holds a string, and
+// variant<long, std::string> v = 5 holds a long. A variant is also made in place from the
+// index or the type of the alternative and the arguments of its constructor. If making the
+// new alternative throws when a variant is assigned or emplaced, the variant is left
+// valueless_by_exception, as std::variant is.
+
+namespace Estd {
+
+template<std::size_t I>
+  struct in_place_index_t {
+    constexpr explicit in_place_index_t() = default;
+  };
+
+template<typename T>
+  struct in_place_type_t {
+    constexpr explicit in_place_type_t() = default;
+  };
+
+// The index of a variant that holds no value.
+constexpr std::size_t variant_npos = std::size_t(-1);
+
+class bad_variant_access : public std::exception {
+public:
+  const char* what() const noexcept override { return "bad_variant_access"; }
+};
+
+// An alternative with no value, for a variant whose first alternative is not default
+// constructible.
+struct monostate { };
+
+constexpr bool operator==(monostate, monostate) { return true; }
+constexpr bool operator!=(monostate, monostate) { return false; }
+constexpr bool operator<(monostate, monostate) { return false; }
+
+template<typename... Ts>
+  class variant;
+
+template<typename V>
+  struct variant_size;
+
+template<typename... Ts>
+  struct variant_size<variant<Ts...>> : size_constant<sizeof...(Ts)> { };
+
+template<std::size_t I, typename V>
+  struct variant_alternative;
+
+template<std::size_t I, typename... Ts>
+  struct variant_alternative<I, variant<Ts...>> {
+    using type = Type_at<I, type_list<Ts...>>;
+  };
+
+template<std::size_t I, typename V>
+  using Variant_alternative = typename variant_alternative<I, V>::type;
+
+namespace impl {
+
+// The union of the types of L: a leaf for one type, and otherwise a union of the unions of
+// the two halves of L. Trivial is false when some type has a destructor, which the union
+// must then declare (and leave to the variant to call).
+template<bool Trivial, typename L, bool Leaf = L::size() == 1>
+  union variant_union;
+
+template<typename T>
+  union variant_union<true, type_list<T>, true> {
+    constexpr variant_union() : none() { }
+
+    template<typename... Args>
+      constexpr explicit variant_union(in_place_index_t<0>, Args&&... args)
+        : value(std::forward<Args>(args)...)
+      { }
+
+    char none;
+    T value;
+  };
+
+template<typename T>
+  union variant_union<false, type_list<T>, true> {
+    constexpr variant_union() : none() { }
+
+    template<typename... Args>
+      constexpr explicit variant_union(in_place_index_t<0>, Args&&... args)
+        : value(std::forward<Args>(args)...)
+      { }
+
+    ~variant_union() { }
+
+    char none;
+    T value;
+  };
+
+template<typename L>
+  union variant_union<true, L, false> {
+    static constexpr std::size_t half = L::size() / 2;
+
+    constexpr variant_union() : none() { }
+
+    template<std::size_t I, typename... Args>
+      constexpr explicit variant_union(in_place_index_t<I>, Args&&... args)
+        : variant_union(boolean_constant<(I < half)>{}, in_place_index_t<I>{}, std::forward<Args>(args)...)
+      { }
+
+    template<std::size_t I, typename... Args>
+      constexpr variant_union(boolean_constant<true>, in_place_index_t<I>, Args&&... args)
+        : left(in_place_index_t<I>{}, std::forward<Args>(args)...)
+      { }
+
+    template<std::size_t I, typename... Args>
+      constexpr variant_union(boolean_constant<false>, in_place_index_t<I>, Args&&... args)
+        : right(in_place_index_t<I - half>{}, std::forward<Args>(args)...)
+      { }
+
+    char none;
+    variant_union<true, Take<half, L>> left;
+    variant_union<true, Drop<half, L>> right;
+  };
+
+template<typename L>
+  union variant_union<false, L, false> {
+    static constexpr std::size_t half = L::size() / 2;
+
+    constexpr variant_union() : none() { }
+
+    template<std::size_t I, typename... Args>
+      constexpr explicit variant_union(in_place_index_t<I>, Args&&... args)
+        : variant_union(boolean_constant<(I < half)>{}, in_place_index_t<I>{}, std::forward<Args>(args)...)
+      { }
+
+    template<std::size_t I, typename... Args>
+      constexpr variant_union(boolean_constant<true>, in_place_index_t<I>, Args&&... args)
+        : left(in_place_index_t<I>{}, std::forward<Args>(args)...)
+      { }
+
+    template<std::size_t I, typename... Args>
+      constexpr variant_union(boolean_constant<false>, in_place_index_t<I>, Args&&... args)
+        : right(in_place_index_t<I - half>{}, std::forward<Args>(args)...)
+      { }
+
+    ~variant_union() { }
+
+    char none;
+    variant_union<false, Take<half, L>> left;
+    variant_union<false, Drop<half, L>> right;
+  };
+
+template<typename T, typename U>
+  using Const_like = Conditional<Const<U>(), const T, T>;
+
+// Alternative I of the union u of the types of L, through the halves that hold it.
+template<std::size_t I, typename L, bool Leaf = L::size() == 1, bool Left = (I < L::size() / 2)>
+  struct union_access;
+
+template<std::size_t I, typename L, bool Left>
+  struct union_access<I, L, true, Left> {
+    template<typename U>
+      static constexpr Const_like<Type_at<I, L>, U>& get(U& u) { return u.value; }
+  };
+
+template<std::size_t I, typename L>
+  struct union_access<I, L, false, true> {
+    template<typename U>
+      static constexpr Const_like<Type_at<I, L>, U>& get(U& u)
+      {
+        return union_access<I, Take<L::size() / 2, L>>::get(u.left);
+      }
+  };
+
+template<std::size_t I, typename L>
+  struct union_access<I, L, false, false> {
+    template<typename U>
+      static constexpr Const_like<Type_at<I, L>, U>& get(U& u)
+      {
+        return union_access<I - L::size() / 2, Drop<L::size() / 2, L>>::get(u.right);
+      }
+  };
+
+// A constexpr array of Op::apply<I> for each I below N. Indexing it with the index of the
+// alternative, and calling the function, is the whole dispatch.
+template<typename Op, typename Fn, std::size_t N, typename S = Estd::make_index_sequence<N>>
+  struct jump_table;
+
+template<typename Op, typename Fn, std::size_t N, std::size_t... I>
+  struct jump_table<Op, Fn, N, index_sequence<I...>> {
+    static constexpr Fn table[N] = {&Op::template apply<I>...};
+  };
+
+template<typename Op, typename Fn, std::size_t N, std::size_t... I>
+  constexpr Fn jump_table<Op, Fn, N, index_sequence<I...>>::table[N];
+
+// The operations of the tables, on the union U of the types of L.
+
+template<typename U, typename L>
+  struct variant_destroy {
+    template<std::size_t I>
+      static void apply(U& u)
+      {
+        using T = Type_at<I, L>;
+        union_access<I, L>::get(u).~T();
+      }
+  };
+
+template<typename U, typename L>
+  struct variant_copy {
+    template<std::size_t I>
+      static void apply(U& u, const U& o)
+      {
+        ::new (static_cast<void*>(&union_access<I, L>::get(u))) Type_at<I, L>(union_access<I, L>::get(o));
+      }
+  };
+
+template<typename U, typename L>
+  struct variant_move {
+    template<std::size_t I>
+      static void apply(U& u, U& o)
+      {
+        ::new (static_cast<void*>(&union_access<I, L>::get(u))) Type_at<I, L>(std::move(union_access<I, L>::get(o)));
+      }
+  };
+
+template<typename U, typename L>
+  struct variant_copy_assign {
+    template<std::size_t I>
+      static void apply(U& u, const U& o) { union_access<I, L>::get(u) = union_access<I, L>::get(o); }
+  };
+
+template<typename U, typename L>
+  struct variant_move_assign {
+    template<std::size_t I>
+      static void apply(U& u, U& o) { union_access<I, L>::get(u) = std::move(union_access<I, L>::get(o)); }
+  };
+
+template<typename U, typename L>
+  struct variant_equal {
+    template<std::size_t I>
+      static constexpr bool apply(const U& a, const U& b)
+      {
+        return union_access<I, L>::get(a) == union_access<I, L>::get(b);
+      }
+  };
+
+template<typename U, typename L>
+  struct variant_less {
+    template<std::size_t I>
+      static constexpr bool apply(const U& a, const U& b)
+      {
+        return union_access<I, L>::get(a) < union_access<I, L>::get(b);
+      }
+  };
+
+// The storage of a variant: the union, and the index of its alternative, which is N when
+// there is none.
+template<bool Trivial, typename... Ts>
+  struct variant_storage {
+    using list = type_list<Ts...>;
+    using union_type = variant_union<Trivial, list>;
+    using index_type = Smallest_unsigned<sizeof...(Ts)>;
+
+    static constexpr std::size_t npos = sizeof...(Ts);
+
+    constexpr variant_storage() : u(), i(npos) { }
+
+    template<std::size_t I, typename... Args>
+      constexpr explicit variant_storage(in_place_index_t<I>, Args&&... args)
+        : u(in_place_index_t<I>{}, std::forward<Args>(args)...), i(I)
+      { }
+
+    // The storage must be valueless.
+    template<std::size_t I, typename... Args>
+      void construct(Args&&... args)
+      {
+        ::new (static_cast<void*>(&union_access<I, list>::get(u))) Type_at<I, list>(std::forward<Args>(args)...);
+        i = I;
+      }
+
+    void destroy()
+    {
+      if (i != npos)
+        jump_table<variant_destroy<union_type, list>, void (*)(union_type&), sizeof...(Ts)>::table[i](u);
+      i = npos;
+    }
+
+    union_type u;
+    index_type i;
+  };
+
+template<typename... Ts>
+  struct variant_destructor : variant_storage<false, Ts...> {
+    using variant_storage<false, Ts...>::variant_storage;
+
+    ~variant_destructor() { this->destroy(); }
+  };
+
+template<typename... Ts>
+  using Variant_storage = Conditional<all_of<Trivially_destructible<Ts>()...>(),
+                                      variant_storage<true, Ts...>,
+                                      variant_destructor<Ts...>>;
+
+// The copy and move operations, spelled out unless every alternative is trivially
+// copyable.
+template<bool Trivial, typename... Ts>
+  struct variant_base : Variant_storage<Ts...> {
+    using Variant_storage<Ts...>::Variant_storage;
+  };
+
+template<typename... Ts>
+  struct variant_base<false, Ts...> : Variant_storage<Ts...> {
+    using storage = Variant_storage<Ts...>;
+    using list = type_list<Ts...>;
+    using union_type = typename storage::union_type;
+
+    using storage::storage;
+
+    variant_base(const variant_base& o)
+      : storage()
+    {
+      if (o.i != storage::npos) {
+        jump_table<variant_copy<union_type, list>, void (*)(union_type&, const union_type&), sizeof...(Ts)>::table[o.i](this->u, o.u);
+        this->i = o.i;
+      }
+    }
+
+    variant_base(variant_base&& o) noexcept(all_of<Nothrow_move_constructible<Ts>()...>())
+      : storage()
+    {
+      move_from(o);
+    }
+
+    variant_base& operator=(const variant_base& o)
+    {
+      if (o.i == storage::npos) {
+        this->destroy();
+      } else if (this->i == o.i) {
+        jump_table<variant_copy_assign<union_type, list>, void (*)(union_type&, const union_type&), sizeof...(Ts)>::table[o.i](this->u, o.u);
+      } else {
+        variant_base tmp(o);
+        this->destroy();
+        move_from(tmp);
+      }
+      return *this;
+    }
+
+    variant_base& operator=(variant_base&& o)
+      noexcept(all_of<Nothrow_move_constructible<Ts>()...>() && all_of<Nothrow_move_assignable<Ts>()...>())
+    {
+      if (o.i == storage::npos) {
+        this->destroy();
+      } else if (this->i == o.i) {
+        jump_table<variant_move_assign<union_type, list>, void (*)(union_type&, union_type&), sizeof...(Ts)>::table[o.i](this->u, o.u);
+      } else {
+        this->destroy();
+        move_from(o);
+      }
+      return *this;
+    }
+
+  private:
+    // This variant must be valueless.
+    void move_from(variant_base& o)
+    {
+      if (o.i != storage::npos) {
+        jump_table<variant_move<union_type, list>, void (*)(union_type&, union_type&), sizeof...(Ts)>::table[o.i](this->u, o.u);
+        this->i = o.i;
+      }
+    }
+  };
+
+template<typename T>
+  using Array_of_one = T[1];
+
+// One of the overloads that choose the alternative a variant is made from: select(T, u)
+// is viable when u converts to T without narrowing, and returns the index I of T.
+template<std::size_t I, typename T>
+  struct variant_overload {
+    template<typename U, typename = decltype(Array_of_one<T>{std::declval<U>()})>
+      static size_constant<I> select(T, U&&);
+  };
+
+// The overloads for the types of L, numbered from I, as a balanced tree of base classes.
+template<std::size_t I, typename L, bool Leaf = L::size() == 1>
+  struct variant_overloads;
+
+template<std::size_t I, typename T>
+  struct variant_overloads<I, type_list<T>, true> : variant_overload<I, T> { };
+
+template<std::size_t I, typename L>
+  struct variant_overloads<I, L, false>
+    : variant_overloads<I, Take<L::size() / 2, L>>,
+      variant_overloads<I + L::size() / 2, Drop<L::size() / 2, L>>
+  {
+    using variant_overloads<I, Take<L::size() / 2, L>>::select;
+    using variant_overloads<I + L::size() / 2, Drop<L::size() / 2, L>>::select;
+  };
+
+// The index, as a size_constant, of the alternative among the types of L that a U
+// selects, or substitution_failure if it selects none, or more than one equally.
+template<typename U, typename L>
+  struct get_variant_selection {
+  private:
+    template<typename X>
+      static auto check(X&& x) -> decltype(variant_overloads<0, L>::select(std::forward<X>(x), std::forward<X>(x)));
+
+    static substitution_failure check(...);
+
+  public:
+    using type = decltype(check(std::declval<U>()));
+  };
+
+}	// namespace impl
+
+template<typename... Ts>
+  class variant
+    : private impl::variant_base<impl::all_of<Trivially_copyable<Ts>()...>(), Ts...>
+  {
+    static_assert(sizeof...(Ts) != 0, "variant: requires at least one alternative");
+    static_assert(impl::all_of<(Object<Ts>() && !Array<Ts>())...>(),
+                  "variant: the alternatives must be object types and not arrays");
+
+    using base = impl::variant_base<impl::all_of<Trivially_copyable<Ts>()...>(), Ts...>;
+    using list = type_list<Ts...>;
+
+    template<typename T>
+      using Alternative_index = size_constant<Index_of<T, list>()>;
+
+    template<typename U>
+      using Selected_index = typename impl::get_variant_selection<U, list>::type;
+
+  public:
+    constexpr variant() : base(in_place_index_t<0>{}) { }
+
+    template<typename U,
+             typename = Enable_if<!Same<Decay<U>, variant>()>,
+             typename I = Selected_index<U>,
+             typename = Enable_if<Substitution_succeeded<I>()>>
+      constexpr variant(U&& x)
+        : base(in_place_index_t<I::value>{}, std::forward<U>(x))
+      { }
+
+    template<std::size_t I, typename... Args>
+      constexpr explicit variant(in_place_index_t<I>, Args&&... args)
+        : base(in_place_index_t<I>{}, std::forward<Args>(args)...)
+      { }
+
+    template<typename T, typename... Args>
+      constexpr explicit variant(in_place_type_t<T>, Args&&... args)
+        : base(in_place_index_t<Alternative_index<T>::value>{}, std::forward<Args>(args)...)
+      { }
+
+    // Assigns to the alternative that U selects, as the constructor chooses it.
+    template<typename U,
+             typename = Enable_if<!Same<Decay<U>, variant>()>,
+             typename I = Selected_index<U>,
+             typename = Enable_if<Substitution_succeeded<I>()>>
+      variant& operator=(U&& x)
+      {
+        if (this->i == I::value)
+          impl::union_access<I::value, list>::get(this->u) = std::forward<U>(x);
+        else
+          emplace<I::value>(std::forward<U>(x));
+        return *this;
+      }
+
+    template<std::size_t I, typename... Args>
+      Type_at<I, list>& emplace(Args&&... args)
+      {
+        this->destroy();
+        this->template construct<I>(std::forward<Args>(args)...);
+        return impl::union_access<I, list>::get(this->u);
+      }
+
+    template<typename T, typename... Args>
+      T& emplace(Args&&... args)
+      {
+        return emplace<Alternative_index<T>::value>(std::forward<Args>(args)...);
+      }
+
+    constexpr std::size_t index() const noexcept
+    {
+      return this->i == base::npos ? variant_npos : this->i;
+    }
+
+    constexpr bool valueless_by_exception() const noexcept { return this->i == base::npos; }
+
+    // Alternative I, which must be the one held. See get and get_if for the checked forms.
+    template<std::size_t I>
+      ESTD_CXX14_CONSTEXPR Type_at<I, list>& unchecked_get() { return impl::union_access<I, list>::get(this->u); }
+
+    template<std::size_t I>
+      constexpr const Type_at<I, list>& unchecked_get() const { return impl::union_access<I, list>::get(this->u); }
+
+    // Variants compare by index first, and then by the values of their alternatives; a
+    // valueless variant comes before the others.
+
+    friend constexpr bool operator==(const variant& a, const variant& b)
+    {
+      return a.i == b.i
+          && (a.i == base::npos
+              || impl::jump_table<impl::variant_equal<typename base::union_type, list>,
+                                  bool (*)(const typename base::union_type&, const typename base::union_type&),
+                                  sizeof...(Ts)>::table[a.i](a.u, b.u));
+    }
+
+    friend constexpr bool operator!=(const variant& a, const variant& b) { return !(a == b); }
+
+    friend constexpr bool operator<(const variant& a, const variant& b)
+    {
+      return b.valueless_by_exception() ? false
+           : a.valueless_by_exception() ? true
+           : a.i != b.i ? a.i < b.i
+           : impl::jump_table<impl::variant_less<typename base::union_type, list>,
+                              bool (*)(const typename base::union_type&, const typename base::union_type&),
+                              sizeof...(Ts)>::table[a.i](a.u, b.u);
+    }
+
+    friend constexpr bool operator>(const variant& a, const variant& b) { return b < a; }
+    friend constexpr bool operator<=(const variant& a, const variant& b) { return !(b < a); }
+    friend constexpr bool operator>=(const variant& a, const variant& b) { return !(a < b); }
+  };
+
+template<typename T, typename... Ts>
+  constexpr bool holds_alternative(const variant<Ts...>& v) noexcept
+  {
+    return v.index() == Index_of<T, type_list<Ts...>>();
+  }
+
+// Alternative I of v, or bad_variant_access if v holds another.
+
+template<std::size_t I, typename... Ts>
+  ESTD_CXX14_CONSTEXPR Type_at<I, type_list<Ts...>>& get(variant<Ts...>& v)
+  {
+    if (v.index() != I)
+      throw bad_variant_access();
+    return v.template unchecked_get<I>();
+  }
+
+template<std::size_t I, typename... Ts>
+  ESTD_CXX14_CONSTEXPR const Type_at<I, type_list<Ts...>>& get(const variant<Ts...>& v)
+  {
+    if (v.index() != I)
+      throw bad_variant_access();
+    return v.template unchecked_get<I>();
+  }
+
+template<std::size_t I, typename... Ts>
+  ESTD_CXX14_CONSTEXPR Type_at<I, type_list<Ts...>>&& get(variant<Ts...>&& v)
+  {
+    return std::move(get<I>(v));
+  }
+
+template<typename T, typename... Ts>
+  ESTD_CXX14_CONSTEXPR T& get(variant<Ts...>& v)
+  {
+    return get<Index_of<T, type_list<Ts...>>()>(v);
+  }
+
+template<typename T, typename... Ts>
+  ESTD_CXX14_CONSTEXPR const T& get(const variant<Ts...>& v)
+  {
+    return get<Index_of<T, type_list<Ts...>>()>(v);
+  }
+
+template<typename T, typename... Ts>
+  ESTD_CXX14_CONSTEXPR T&& get(variant<Ts...>&& v)
+  {
+    return std::move(get<Index_of<T, type_list<Ts...>>()>(v));
+  }
+
+// A pointer to alternative I of *v, or null if *v holds another.
+
+template<std::size_t I, typename... Ts>
+  ESTD_CXX14_CONSTEXPR Type_at<I, type_list<Ts...>>* get_if(variant<Ts...>* v) noexcept
+  {
+    return v && v->index() == I ? &v->template unchecked_get<I>() : nullptr;
+  }
+
+template<std::size_t I, typename... Ts>
+  constexpr const Type_at<I, type_list<Ts...>>* get_if(const variant<Ts...>* v) noexcept
+  {
+    return v && v->index() == I ? &v->template unchecked_get<I>() : nullptr;
+  }
+
+template<typename T, typename... Ts>
+  ESTD_CXX14_CONSTEXPR T* get_if(variant<Ts...>* v) noexcept
+  {
+    return get_if<Index_of<T, type_list<Ts...>>()>(v);
+  }
+
+template<typename T, typename... Ts>
+  constexpr const T* get_if(const variant<Ts...>* v) noexcept
+  {
+    return get_if<Index_of<T, type_list<Ts...>>()>(v);
+  }
+
+namespace impl {
+
+// x, as an rvalue unless V is an lvalue reference.
+template<typename V, typename T>
+  constexpr Conditional<Lvalue_reference<V>(), T&, T&&> forward_like(T& x)
+  {
+    return static_cast<Conditional<Lvalue_reference<V>(), T&, T&&>>(x);
+  }
+
+// Calls f with alternative I of v, which is an lvalue or an rvalue as v is. Every
+// alternative must give f the same result type.
+template<typename F, typename V>
+  struct variant_visit {
+    using result = decltype(std::declval<F>()(forward_like<V>(std::declval<V&>().template unchecked_get<0>())));
+
+    template<std::size_t I>
+      static constexpr result apply(F&& f, V&& v)
+      {
+        return std::forward<F>(f)(forward_like<V>(v.template unchecked_get<I>()));
+      }
+  };
+
+}	// namespace impl
+
+// f applied to the alternative that v holds, through one indirect call; or
+// bad_variant_access if v is valueless.
+template<typename F, typename V,
+         std::size_t N = variant_size<Remove_cv<Remove_reference<V>>>::value,
+         typename Visit = impl::variant_visit<F, V>>
+  ESTD_CXX14_CONSTEXPR typename Visit::result visit(F&& f, V&& v)
+  {
+    if (v.valueless_by_exception())
+      throw bad_variant_access();
+    return impl::jump_table<Visit, typename Visit::result (*)(F&&, V&&), N>::table[v.index()](
+             std::forward<F>(f), std::forward<V>(v));
+  }
+
+}	// namespace Estd
+
+#endif	// VARIANT_H